@@ -0,0 +1,93 @@
+#include "Benchmarks.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+void Benchmarks::setParameter(DFAMSynthAudioProcessor& processor, const juce::String& id, float value)
+{
+    auto* parameter = processor.getAPVTS().getParameter(id);
+    jassert(parameter != nullptr);
+    parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+}
+
+void Benchmarks::setUpPatch(DFAMSynthAudioProcessor& processor, int numModSlots)
+{
+    setParameter(processor, "seqRun", 1.0f);
+    setParameter(processor, "delayMix", 0.3f);
+    setParameter(processor, "ringModMix", 0.3f);
+    setParameter(processor, "reverbMix", 0.3f);
+
+    // Every source and destination in turn
+    for (int slot = 0; slot < numModSlots; ++slot)
+    {
+        const juce::String number(slot + 1);
+        setParameter(processor, "modSrc" + number, static_cast<float>(slot % ModMatrix::NUM_SOURCES + 1));
+        setParameter(processor, "modDst" + number, static_cast<float>(slot % ModMatrix::NUM_DESTINATIONS + 1));
+        setParameter(processor, "modAmt" + number, 0.3f);
+    }
+}
+
+void Benchmarks::prepare(DFAMSynthAudioProcessor& processor)
+{
+    processor.setRateAndBufferSizeDetails(SAMPLE_RATE, BLOCK_SIZE);
+    processor.prepareToPlay(SAMPLE_RATE, BLOCK_SIZE);
+    renderTimed(processor, 1.0);
+}
+
+double Benchmarks::renderTimed(DFAMSynthAudioProcessor& processor, double seconds)
+{
+    juce::AudioBuffer<float> buffer(2, BLOCK_SIZE);
+    juce::MidiBuffer midi;
+    const int numBlocks = std::max(1, static_cast<int>(seconds * SAMPLE_RATE / BLOCK_SIZE));
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        buffer.clear();
+        processor.processBlock(buffer, midi);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (static_cast<double>(numBlocks) * BLOCK_SIZE);
+}
+
+int main(int argc, char* argv[])
+{
+    // The APVTS is a Timer, so JUCE's message manager has to exist
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const std::vector<std::pair<const char*, void (*)()>> benchmarks {
+        { "modrate", Benchmarks::runModRateBenchmark },
+        { "scaling", Benchmarks::runScalingBenchmark },
+        { "voices", Benchmarks::runVoiceKernelBenchmark }
+    };
+
+    std::vector<void (*)()> selected;
+    for (int i = 1; i < argc; ++i)
+    {
+        const auto found = std::find_if(benchmarks.begin(), benchmarks.end(),
+                                        [name = argv[i]](const auto& benchmark) { return std::strcmp(benchmark.first, name) == 0; });
+        if (found == benchmarks.end())
+        {
+            std::printf("Unknown benchmark \"%s\". Available:", argv[i]);
+            for (const auto& benchmark : benchmarks)
+                std::printf(" %s", benchmark.first);
+            std::printf("\n");
+            return 1;
+        }
+        selected.push_back(found->second);
+    }
+
+    if (selected.empty())
+        for (const auto& benchmark : benchmarks)
+            selected.push_back(benchmark.second);
+
+    std::printf("SIMD kernels: %s\n\n", SimdDispatch::getVariantName(SimdDispatch::getKernels().variant));
+    for (auto* run : selected)
+        run();
+
+    return 0;
+}
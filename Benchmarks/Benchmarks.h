@@ -0,0 +1,30 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+// Benchmarks that run DFAMSynthAudioProcessor outside a host. Each prints its own table;
+// the app runs the ones named on its command line, or all of them.
+namespace Benchmarks
+{
+    constexpr double SAMPLE_RATE = 48000.0;
+    constexpr int BLOCK_SIZE = 512;
+
+    // Set a parameter by ID to a value in its own units (a choice by its index)
+    void setParameter(DFAMSynthAudioProcessor& processor, const juce::String& id, float value);
+
+    // A running patch: sequencer on, all three FX stages mixed in, and the first
+    // numModSlots mod slots routed
+    void setUpPatch(DFAMSynthAudioProcessor& processor, int numModSlots);
+
+    // prepareToPlay at SAMPLE_RATE and BLOCK_SIZE, then a second of audio to settle
+    void prepare(DFAMSynthAudioProcessor& processor);
+
+    // Render the given length of audio in BLOCK_SIZE blocks. Returns wall-clock ns per
+    // sample.
+    double renderTimed(DFAMSynthAudioProcessor& processor, double seconds);
+
+    void runModRateBenchmark();
+    void runScalingBenchmark();
+    void runVoiceKernelBenchmark();
+}
@@ -0,0 +1,33 @@
+#include "Benchmarks.h"
+#include <cstdio>
+
+// The whole processor at each modRate, against the audio-rate matrix. Only the modulation
+// stage changes between runs, so the difference is its cost.
+void Benchmarks::runModRateBenchmark()
+{
+    static const char* const rateNames[] = { "Audio", "16 samples", "32 samples", "64 samples" };
+
+    std::printf("Mod matrix rate: whole processor, ns per sample\n");
+
+    for (int numModSlots : { 4, 16 })
+    {
+        double audioRate = 0.0;
+
+        for (int rate = 0; rate < 4; ++rate)
+        {
+            DFAMSynthAudioProcessor processor;
+            setUpPatch(processor, numModSlots);
+            setParameter(processor, "modRate", static_cast<float>(rate));
+            prepare(processor);
+
+            const double nsPerSample = renderTimed(processor, 20.0);
+            if (rate == 0)
+                audioRate = nsPerSample;
+
+            std::printf("  %2d slots  %-10s  %7.1f ns/sample  %5.2fx\n",
+                        numModSlots, rateNames[rate], nsPerSample, audioRate / nsPerSample);
+        }
+    }
+
+    std::printf("\n");
+}
@@ -0,0 +1,72 @@
+#include "Benchmarks.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// One processor per thread, as a host runs separate plugin instances in parallel. The
+// instances share no mutable state, so each should render as fast as a lone one; efficiency
+// below 100% is contention for shared cache and memory bandwidth (or false sharing).
+void Benchmarks::runScalingBenchmark()
+{
+    constexpr double seconds = 10.0;
+    const int maxThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    std::vector<int> threadCounts;
+    for (int n = 1; n < maxThreads; n *= 2)
+        threadCounts.push_back(n);
+    threadCounts.push_back(maxThreads);
+
+    std::printf("Instance scaling: one processor per thread, %.0f s of audio each\n", seconds);
+    std::printf("  threads  ns/sample  x realtime  efficiency\n");
+
+    double singleNsPerSample = 0.0;
+
+    for (int numThreads : threadCounts)
+    {
+        // Created and prepared here, on the message thread
+        std::vector<std::unique_ptr<DFAMSynthAudioProcessor>> processors;
+        for (int i = 0; i < numThreads; ++i)
+        {
+            processors.push_back(std::make_unique<DFAMSynthAudioProcessor>());
+            setUpPatch(*processors.back(), 4);
+            prepare(*processors.back());
+        }
+
+        // Every thread waits at the start line, so they all render at once
+        std::vector<double> nsPerSample(static_cast<size_t>(numThreads));
+        std::atomic<int> waiting { numThreads };
+        std::vector<std::thread> threads;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < numThreads; ++i)
+        {
+            threads.emplace_back([&, i]
+            {
+                waiting.fetch_sub(1);
+                while (waiting.load() > 0)
+                    std::this_thread::yield();
+
+                nsPerSample[static_cast<size_t>(i)] = renderTimed(*processors[static_cast<size_t>(i)], seconds);
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        double meanNsPerSample = 0.0;
+        for (double ns : nsPerSample)
+            meanNsPerSample += ns / numThreads;
+        if (numThreads == 1)
+            singleNsPerSample = meanNsPerSample;
+
+        std::printf("  %7d  %9.1f  %10.1f  %9.0f%%\n",
+                    numThreads, meanNsPerSample, numThreads * seconds / elapsed, 100.0 * singleNsPerSample / meanNsPerSample);
+    }
+
+    std::printf("\n");
+}
@@ -0,0 +1,70 @@
+#include "Benchmarks.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+// Each specialised renderVoice<features> against the all-features instantiation, which
+// takes every branch the specialisations compile out. Both run on the same processor and
+// sub-block, with the VCA open, straight through voiceKernels.
+struct Benchmarks::VoiceKernelBenchmark
+{
+    using Processor = DFAMSynthAudioProcessor;
+    static constexpr int blockSize = Processor::SUB_BLOCK_SIZE;
+    static constexpr int repeats = 20000;
+
+    static double timeKernel(Processor& processor, int features, float* left, float* right)
+    {
+        const auto kernel = Processor::voiceKernels[static_cast<size_t>(features)];
+        const bool stereo = (features & Processor::StereoFeature) != 0;
+
+        (processor.*kernel)(0, blockSize, true, left, stereo ? right : nullptr);  // warm up
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r)
+            (processor.*kernel)(0, blockSize, true, left, stereo ? right : nullptr);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        return std::chrono::duration<double, std::nano>(elapsed).count() / (static_cast<double>(repeats) * blockSize);
+    }
+
+    static std::string describe(int features)
+    {
+        static const char* const names[] = { "seq>VCO1", "seq>VCO2", "drone", "ring", "stereo" };
+
+        std::string enabled;
+        for (int bit = 0; bit < 5; ++bit)
+            if ((features & (1 << bit)) != 0)
+                enabled += enabled.empty() ? names[bit] : std::string(" ") + names[bit];
+        return enabled.empty() ? "(none)" : enabled;
+    }
+
+    static void run()
+    {
+        // A running patch leaves the envelope, mod and noise buffers of a real sub-block
+        Processor processor;
+        setUpPatch(processor, 4);
+        prepare(processor);
+
+        float left[blockSize] = {};
+        float right[blockSize] = {};
+        const int allFeatures = Processor::NUM_VOICE_KERNELS - 1;
+
+        std::printf("Voice kernels: renderVoice<features> against all features, ns per sample\n");
+        std::printf("  %2s  %-38s  %7s  %7s  %6s\n", "", "features", "special", "all", "ratio");
+
+        for (int features = 0; features < Processor::NUM_VOICE_KERNELS; ++features)
+        {
+            const double specialised = timeKernel(processor, features, left, right);
+            const double generic = timeKernel(processor, allFeatures, left, right);
+
+            std::printf("  %2d  %-38s  %7.1f  %7.1f  %5.2fx\n",
+                        features, describe(features).c_str(), specialised, generic, generic / specialised);
+        }
+
+        std::printf("\n");
+    }
+};
+
+void Benchmarks::runVoiceKernelBenchmark()
+{
+    VoiceKernelBenchmark::run();
+}
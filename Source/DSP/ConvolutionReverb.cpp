@@ -0,0 +1,107 @@
+#include "ConvolutionReverb.h"
+#include <cmath>
+#include <memory>
+#include <utility>
+
+void ConvolutionReverb::prepare(double newSampleRate, int newMaxBlockSize, float* storage)
+{
+    sampleRate = newSampleRate;
+    maxBlockSize = newMaxBlockSize;
+    dryLeft = storage;
+    dryRight = storage + maxBlockSize;
+
+    // Also resamples a loaded IR to the new rate, on the background thread
+    convolution.prepare({ sampleRate, static_cast<juce::uint32>(maxBlockSize), 2 });
+    reset();
+}
+
+void ConvolutionReverb::reset()
+{
+    convolution.reset();
+    filterStateL = 0.0f;
+    filterStateR = 0.0f;
+}
+
+bool ConvolutionReverb::loadImpulseResponse(const juce::File& file)
+{
+    // Only the header is read here, for the length cap in the file's own samples; the
+    // convolution decodes the file on its background thread
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+    std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(file));
+    if (reader == nullptr || reader->lengthInSamples <= 0 || reader->sampleRate <= 0.0)
+        return false;
+
+    const auto maxLength = static_cast<size_t>(reader->sampleRate * MAX_IR_SECONDS);
+    reader.reset();
+
+    convolution.loadImpulseResponse(file, juce::dsp::Convolution::Stereo::yes,
+                                    juce::dsp::Convolution::Trim::yes, maxLength,
+                                    juce::dsp::Convolution::Normalise::yes);
+    loaded.store(true);
+    return true;
+}
+
+void ConvolutionReverb::clearImpulseResponse()
+{
+    // A one-sample unit impulse, so the convolution stops reporting the old IR's size
+    juce::AudioBuffer<float> unit(1, 1);
+    unit.setSample(0, 0, 1.0f);
+    convolution.loadImpulseResponse(std::move(unit), sampleRate, juce::dsp::Convolution::Stereo::no,
+                                    juce::dsp::Convolution::Trim::no, juce::dsp::Convolution::Normalise::no);
+    loaded.store(false);
+}
+
+bool ConvolutionReverb::hasImpulseResponse() const
+{
+    return loaded.load() && convolution.getCurrentIRSize() > 1;
+}
+
+void ConvolutionReverb::pollImpulseResponse()
+{
+    if (!loaded.load() || convolution.getCurrentIRSize() > 1)
+        return;
+
+    float silence[2] = {};
+    float* channels[] = { silence, silence + 1 };
+    juce::dsp::AudioBlock<float> block(channels, 2u, 1u);
+    convolution.process(juce::dsp::ProcessContextReplacing<float>(block));
+}
+
+void ConvolutionReverb::setFilterCutoff(float hz)
+{
+    filterCoeff = std::exp(-2.0f * juce::MathConstants<float>::pi * hz / static_cast<float>(sampleRate));
+}
+
+void ConvolutionReverb::process(float* left, float* right, int numSamples)
+{
+    jassert(numSamples <= maxBlockSize);
+
+    juce::FloatVectorOperations::copy(dryLeft, left, numSamples);
+    if (right != nullptr)
+        juce::FloatVectorOperations::copy(dryRight, right, numSamples);
+
+    float* channels[] = { left, right };
+    juce::dsp::AudioBlock<float> block(channels, right != nullptr ? 2u : 1u, static_cast<size_t>(numSamples));
+    convolution.process(juce::dsp::ProcessContextReplacing<float>(block));
+
+    const float dryGain = 1.0f - mix;
+    float filterL = filterStateL;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        filterL = filterL * filterCoeff + left[i] * (1.0f - filterCoeff);
+        left[i] = dryLeft[i] * dryGain + filterL * mix;
+    }
+    filterStateL = filterL;
+
+    if (right != nullptr)
+    {
+        float filterR = filterStateR;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            filterR = filterR * filterCoeff + right[i] * (1.0f - filterCoeff);
+            right[i] = dryRight[i] * dryGain + filterR * mix;
+        }
+        filterStateR = filterR;
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+
+// The reverb stage's convolution mode: the signal through a recorded room's impulse
+// response, then the wet lowpass and the dry/wet mix.
+//
+// Built on juce::dsp::Convolution with non-uniform partitions. Both parts of the IR run
+// through uniform-partitioned FFT convolution without added latency: the first HEAD_SIZE
+// samples in partitions of HEAD_SIZE, the rest in one level of longer partitions, which
+// take fewer transforms per sample. The cost depends on the IR length only, which is capped
+// at MAX_IR_SECONDS.
+//
+// loadImpulseResponse() may be called from any thread and never blocks the audio thread.
+// The file is decoded, resampled to the host rate and transformed on the convolution's
+// background thread; the audio thread picks the new engine up with a lock-free swap, the
+// next time it processes, and crossfades to it. hasImpulseResponse() only reports the IR
+// once that has happened, so the caller keeps another reverb running until then.
+class ConvolutionReverb
+{
+public:
+    static constexpr int HEAD_SIZE = 256;  // samples in the first partitions
+    static constexpr double MAX_IR_SECONDS = 4.0;
+
+    // Floats of storage prepare() needs: the dry signal of a block
+    static int getRequiredStorage(int maxBlockSize) { return maxBlockSize * 2; }
+
+    // storage holds getRequiredStorage(maxBlockSize) floats; clears the reverb
+    void prepare(double sampleRate, int maxBlockSize, float* storage);
+    void reset();
+
+    // Any thread. Returns false (and keeps the current IR) if the file can't be read.
+    bool loadImpulseResponse(const juce::File& file);
+    void clearImpulseResponse();
+
+    // Audio thread. Whether the convolution is running the IR asked for, rather than still
+    // loading it.
+    bool hasImpulseResponse() const;
+
+    // Audio thread, for blocks the reverb isn't processing. The convolution only takes up a
+    // finished load while it processes, so while one is in flight this runs it on a sample
+    // of silence. Reset the reverb before using it again.
+    void pollImpulseResponse();
+
+    void setFilterCutoff(float hz);
+    void setMix(float newMix) { mix = newMix; }
+
+    // Samples the output can stay quiet while the reverb still holds input: the longest IR
+    // (rather than the current one, as a longer one may be on its way in)
+    int getTailHoldSamples() const { return static_cast<int>(sampleRate * MAX_IR_SECONDS); }
+
+    // In place; right is null for mono output. At most maxBlockSize samples.
+    void process(float* left, float* right, int numSamples);
+
+private:
+    juce::dsp::Convolution convolution { juce::dsp::Convolution::NonUniform { HEAD_SIZE } };
+    std::atomic<bool> loaded { false };  // an IR was asked for and not cleared since
+
+    double sampleRate = 44100.0;
+    int maxBlockSize = 0;
+    float* dryLeft = nullptr;
+    float* dryRight = nullptr;
+
+    float filterCoeff = 0.0f;
+    float filterStateL = 0.0f;
+    float filterStateR = 0.0f;
+    float mix = 0.0f;
+};
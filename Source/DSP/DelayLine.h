@@ -0,0 +1,95 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cstddef>
+
+// Circular delay line over a power-of-two buffer, so wrapping is a mask instead of a modulo.
+//
+// The storage is owned elsewhere (the processor carves it from its ScratchArena) and must
+// hold getBufferSize(maxDelay) samples. Delays are measured the way the processor's loops
+// use them: reads come before the write for the same sample, so a delay of 1 returns the
+// sample pushed last.
+template <typename T>
+class DelayLine
+{
+public:
+    // Power-of-two buffer length for delays up to maxDelaySamples (with room for the
+    // allpass read's extra tap)
+    static int getBufferSize(int maxDelaySamples)
+    {
+        return juce::nextPowerOfTwo(maxDelaySamples + 4);
+    }
+
+    void setBuffer(T* storage, int bufferSize)
+    {
+        jassert(juce::isPowerOfTwo(bufferSize));
+        buffer = storage;
+        size = bufferSize;
+        mask = bufferSize - 1;
+        reset();
+    }
+
+    void reset()
+    {
+        if (buffer != nullptr)
+            std::fill(buffer, buffer + size, T());
+        writePos = 0;
+        allpassState = T();
+    }
+
+    int getMaxDelay() const { return size - 4; }
+
+    // === Sample access ===
+
+    void push(T input)
+    {
+        buffer[writePos] = input;
+        writePos = (writePos + 1) & mask;
+    }
+
+    // Integer delay, 1 to getMaxDelay()
+    T read(int delay) const
+    {
+        return buffer[(writePos - delay) & mask];
+    }
+
+    // Fractional delays go through a first-order Thiran allpass: flat magnitude, for fixed
+    // or slowly varying delays in feedback loops. The delay is split into a whole part and
+    // a coefficient up front, for callers that hold it over many samples.
+    struct AllpassDelay
+    {
+        int whole = 1;
+        T alpha = T();
+    };
+
+    static AllpassDelay getAllpassDelay(float delay)
+    {
+        int delayInt = static_cast<int>(delay);
+        T frac = static_cast<T>(delay - static_cast<float>(delayInt));
+
+        // Keep the fractional part in [0.618, 1.618) where the Thiran allpass has its
+        // flattest group delay
+        if (frac < T(0.618) && delayInt > 1)
+        {
+            --delayInt;
+            frac += T(1);
+        }
+
+        return { delayInt, (T(1) - frac) / (T(1) + frac) };
+    }
+
+    T readAllpass(const AllpassDelay& delay)
+    {
+        const T output = read(delay.whole + 1) + delay.alpha * (read(delay.whole) - allpassState);
+        allpassState = output;
+        return output;
+    }
+
+private:
+    T* buffer = nullptr;
+    int size = 0;
+    int mask = 0;
+    int writePos = 0;
+    T allpassState = T();
+};
@@ -1,6 +1,12 @@
 #include "Envelope.h"
+#include <algorithm>
 #include <cmath>
 
+namespace
+{
+    constexpr float SILENCE_THRESHOLD = 0.0001f;
+}
+
 Envelope::Envelope()
 {
 }
@@ -10,12 +16,17 @@ void Envelope::prepare(double newSampleRate)
     sampleRate = newSampleRate;
     currentValue = 0.0f;
     active = false;
+    triggered = false;
     updateCoefficients();
 }
 
 void Envelope::setDecayTime(float decayMs)
 {
-    decayTime = decayMs / 1000.0f;  // convert to seconds
+    const float newDecayTime = decayMs / 1000.0f;  // convert to seconds
+    if (newDecayTime == decayTime)
+        return;
+
+    decayTime = newDecayTime;
     updateCoefficients();
 }
 
@@ -24,6 +35,7 @@ void Envelope::trigger(float velocity)
     targetVelocity = velocity;
     currentValue = velocity;
     active = true;
+    triggered = true;
 }
 
 float Envelope::process()
@@ -32,12 +44,13 @@ float Envelope::process()
         return 0.0f;
 
     float output = currentValue;
+    triggered = false;
 
     // Exponential decay
     currentValue *= decayCoeff;
 
     // Stop when below threshold
-    if (currentValue < 0.0001f)
+    if (currentValue < SILENCE_THRESHOLD)
     {
         currentValue = 0.0f;
         active = false;
@@ -46,6 +59,48 @@ float Envelope::process()
     return output;
 }
 
+bool Envelope::render(float* output, int numSamples)
+{
+    if (!active)
+    {
+        juce::FloatVectorOperations::clear(output, numSamples);
+        return false;
+    }
+
+    const int tableLength = static_cast<int>(decayPowers.size()) - 1;
+    int done = 0;
+
+    while (done < numSamples)
+    {
+        const int chunk = std::min(numSamples - done, tableLength);
+        float* out = output + done;
+
+        juce::FloatVectorOperations::copyWithMultiply(out, decayPowers.data(), currentValue, chunk);
+        currentValue *= decayPowers[static_cast<size_t>(chunk)];
+        done += chunk;
+
+        if (currentValue < SILENCE_THRESHOLD)
+        {
+            // The decay ends in this chunk: the values are falling, so everything from the
+            // first one below the threshold on is silence (the trigger value itself is
+            // always emitted, as process() does)
+            int end = triggered ? 1 : 0;
+            while (end < chunk && out[end] >= SILENCE_THRESHOLD)
+                ++end;
+
+            juce::FloatVectorOperations::clear(out + end, numSamples - (done - chunk) - end);
+            currentValue = 0.0f;
+            active = false;
+            triggered = false;
+            return end > 0 || done - chunk > 0;
+        }
+
+        triggered = false;
+    }
+
+    return true;
+}
+
 void Envelope::updateCoefficients()
 {
     // Calculate decay coefficient for exponential decay
@@ -59,4 +114,12 @@ void Envelope::updateCoefficients()
     {
         decayCoeff = 0.0f;
     }
+
+    // Powers for render(), accumulated in double so the last entries stay accurate
+    double power = 1.0;
+    for (auto& entry : decayPowers)
+    {
+        entry = static_cast<float>(power);
+        power *= decayCoeff;
+    }
 }
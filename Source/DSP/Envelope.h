@@ -1,6 +1,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 
 class Envelope
 {
@@ -8,21 +9,28 @@ public:
     Envelope();
 
     void prepare(double sampleRate);
-    void setDecayTime(float decayMs);
+    void setDecayTime(float decayMs);  // only recomputes the coefficient if the time changed
     void trigger(float velocity = 1.0f);
 
     // Get next envelope value (0 to 1)
     float process();
 
+    // Fill a block with the next numSamples values. The decay is evaluated as
+    // value * coeff^k from a table of powers rather than sample by sample.
+    // Returns false if the whole block is silent, so callers can skip work downstream.
+    bool render(float* output, int numSamples);
+
     bool isActive() const { return active; }
 
 private:
     double sampleRate = 44100.0;
     float decayTime = 0.2f;   // in seconds
     float decayCoeff = 0.0f;
+    std::array<float, 65> decayPowers = {};  // decayCoeff^k, k = 0 to 64
     float currentValue = 0.0f;
     float targetVelocity = 1.0f;
     bool active = false;
+    bool triggered = false;  // the next value is the trigger value, emitted even below the threshold
 
     void updateCoefficients();
 };
@@ -0,0 +1,449 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <immintrin.h>
+ #define DFAM_FASTMATH_SSE2 1
+
+ // The AVX2 and AVX-512 versions are built for their instruction sets whatever the target
+ // (per function with GCC/Clang, which is the default with MSVC). They must only run after a
+ // CPUID check, so exp2Block reaches them through SimdDispatch.
+ #if defined(__GNUC__) || defined(__clang__)
+  #define DFAM_TARGET_AVX2 __attribute__((target("avx2")))
+  #define DFAM_TARGET_AVX512 __attribute__((target("avx512f")))
+ #else
+  #define DFAM_TARGET_AVX2
+  #define DFAM_TARGET_AVX512
+ #endif
+ #define DFAM_FASTMATH_AVX2 1
+ #define DFAM_FASTMATH_AVX512 1
+#endif
+
+#include "SimdDispatch.h"
+
+// Polynomial/rational approximations of the transcendental functions used per sample.
+// Scalar versions are always available and SSE2 versions whenever the target has it (all
+// x86-64). AVX2 and AVX-512 versions are compiled in alongside on x86, and exp2Block runs
+// the widest one the CPU supports.
+//
+// Max errors (measured against double-precision libm over the stated ranges):
+//   exp2   relative 2e-7           x in [-126, 127], clamped outside
+//   exp    relative 7e-7           |x| < 10 (grows to 4e-6 near |x| = 87 from rounding x * log2(e))
+//   log2   absolute 4e-7           x in [2^-8, 2^8] (beyond that, half an ulp of the result)
+//   pow    relative 3e-7 * max(1, |log2 result|), base > 0
+//   sin2Pi absolute 2e-7           any phase (in cycles)
+//   cos2Pi absolute 4e-7           |phase| <= 1 (beyond that, plus pi ulps of phase + 0.25)
+//   tan    relative 2e-6           |x| < 0.45 * pi
+//   tanh   absolute 1e-4           all x (largest near |x| = 5, below 4e-7 for |x| < 2.5)
+namespace FastMath
+{
+    namespace detail
+    {
+        // 2^x on [0, 1), Chebyshev fit
+        constexpr float exp2C0 = 0.99999989835f;
+        constexpr float exp2C1 = 0.69315448966f;
+        constexpr float exp2C2 = 0.24014181820f;
+        constexpr float exp2C3 = 0.05586033708f;
+        constexpr float exp2C4 = 0.00894959042f;
+        constexpr float exp2C5 = 0.00189375406f;
+
+        // sin(2 pi x) / x as a polynomial in x^2 on |x| <= 0.25, Chebyshev fit
+        constexpr float sinC0 = 6.28318528015f;
+        constexpr float sinC1 = -41.3416806133f;
+        constexpr float sinC2 = 81.6024763689f;
+        constexpr float sinC3 = -76.5811726447f;
+        constexpr float sinC4 = 39.7598270885f;
+
+        constexpr float tanhClamp = 4.97f;
+
+        inline float bitsToFloat(uint32_t bits)
+        {
+            float f;
+            std::memcpy(&f, &bits, sizeof(f));
+            return f;
+        }
+
+        inline uint32_t floatToBits(float f)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &f, sizeof(bits));
+            return bits;
+        }
+    }
+
+    //==========================================================================
+    // Scalar
+
+    inline float exp2(float x)
+    {
+        using namespace detail;
+        x = x < -126.0f ? -126.0f : (x > 127.0f ? 127.0f : x);
+        const float xi = std::floor(x);
+        const float f = x - xi;
+        const float p = exp2C0 + f * (exp2C1 + f * (exp2C2 + f * (exp2C3 + f * (exp2C4 + f * exp2C5))));
+        return p * bitsToFloat(static_cast<uint32_t>(static_cast<int>(xi) + 127) << 23);
+    }
+
+    inline float exp(float x)
+    {
+        return exp2(x * 1.44269504089f);
+    }
+
+    inline float log2(float x)
+    {
+        using namespace detail;
+        // Split into exponent and mantissa in [sqrt(0.5), sqrt(2)), then atanh series
+        const uint32_t bits = floatToBits(x);
+        int exponent = static_cast<int>((bits >> 23) & 0xff) - 127;
+        float m = bitsToFloat((bits & 0x007fffffu) | 0x3f800000u);
+        if (m > 1.41421356f)
+        {
+            m *= 0.5f;
+            ++exponent;
+        }
+        const float t = (m - 1.0f) / (m + 1.0f);
+        const float t2 = t * t;
+        const float series = t * (2.88539008f + t2 * (0.961796694f + t2 * (0.577078017f + t2 * 0.412198583f)));
+        return static_cast<float>(exponent) + series;
+    }
+
+    // base^exponent for base > 0 (returns 0 for base <= 0)
+    inline float pow(float base, float exponent)
+    {
+        return base > 0.0f ? exp2(exponent * log2(base)) : 0.0f;
+    }
+
+    // sin(2 pi phase), phase in cycles (any range)
+    inline float sin2Pi(float phase)
+    {
+        using namespace detail;
+        float x = phase - std::floor(phase + 0.5f);    // -0.5 to 0.5
+        if (x > 0.25f)
+            x = 0.5f - x;
+        else if (x < -0.25f)
+            x = -0.5f - x;
+        const float x2 = x * x;
+        return x * (sinC0 + x2 * (sinC1 + x2 * (sinC2 + x2 * (sinC3 + x2 * sinC4))));
+    }
+
+    // cos(2 pi phase), phase in cycles (any range)
+    inline float cos2Pi(float phase)
+    {
+        return sin2Pi(phase + 0.25f);
+    }
+
+    // tan(x) for |x| < pi / 2
+    inline float tan(float x)
+    {
+        const float phase = x * 0.159154943f;
+        return sin2Pi(phase) / cos2Pi(phase);
+    }
+
+    // Rational tanh (Lambert continued fraction), saturating to +/-1 past |x| = 4.97
+    inline float tanh(float x)
+    {
+        using namespace detail;
+        if (x > tanhClamp) return 1.0f;
+        if (x < -tanhClamp) return -1.0f;
+        const float x2 = x * x;
+        const float num = x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)));
+        const float den = 135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f));
+        return num / den;
+    }
+
+    //==========================================================================
+    // SSE2 (4 lanes)
+
+   #if DFAM_FASTMATH_SSE2
+    inline __m128 floor(__m128 x)
+    {
+        // Truncate, then step down where truncation rounded towards zero from below
+        const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+        return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, x), _mm_set1_ps(1.0f)));
+    }
+
+    inline __m128 exp2(__m128 x)
+    {
+        using namespace detail;
+        x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-126.0f)), _mm_set1_ps(127.0f));
+        const __m128 xi = floor(x);
+        const __m128 f = _mm_sub_ps(x, xi);
+
+        __m128 p = _mm_set1_ps(exp2C5);
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(exp2C4));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(exp2C3));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(exp2C2));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(exp2C1));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(exp2C0));
+
+        const __m128i bits = _mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(xi), _mm_set1_epi32(127)), 23);
+        return _mm_mul_ps(p, _mm_castsi128_ps(bits));
+    }
+
+    inline __m128 sin2Pi(__m128 phase)
+    {
+        using namespace detail;
+        __m128 x = _mm_sub_ps(phase, floor(_mm_add_ps(phase, _mm_set1_ps(0.5f))));
+
+        // Fold into [-0.25, 0.25] using sin(pi - a) = sin(a)
+        const __m128 above = _mm_cmpgt_ps(x, _mm_set1_ps(0.25f));
+        const __m128 below = _mm_cmplt_ps(x, _mm_set1_ps(-0.25f));
+        const __m128 foldedAbove = _mm_sub_ps(_mm_set1_ps(0.5f), x);
+        const __m128 foldedBelow = _mm_sub_ps(_mm_set1_ps(-0.5f), x);
+        x = _mm_or_ps(_mm_andnot_ps(_mm_or_ps(above, below), x),
+                      _mm_or_ps(_mm_and_ps(above, foldedAbove), _mm_and_ps(below, foldedBelow)));
+
+        const __m128 x2 = _mm_mul_ps(x, x);
+        __m128 p = _mm_set1_ps(sinC4);
+        p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(sinC3));
+        p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(sinC2));
+        p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(sinC1));
+        p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(sinC0));
+        return _mm_mul_ps(p, x);
+    }
+
+    inline __m128 tanh(__m128 x)
+    {
+        using namespace detail;
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        const __m128 saturated = _mm_cmpgt_ps(_mm_andnot_ps(signMask, x), _mm_set1_ps(tanhClamp));
+        const __m128 unit = _mm_or_ps(_mm_and_ps(x, signMask), _mm_set1_ps(1.0f));
+
+        const __m128 xc = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-tanhClamp)), _mm_set1_ps(tanhClamp));
+        const __m128 x2 = _mm_mul_ps(xc, xc);
+        __m128 num = _mm_add_ps(x2, _mm_set1_ps(378.0f));
+        num = _mm_add_ps(_mm_mul_ps(num, x2), _mm_set1_ps(17325.0f));
+        num = _mm_add_ps(_mm_mul_ps(num, x2), _mm_set1_ps(135135.0f));
+        num = _mm_mul_ps(num, xc);
+        __m128 den = _mm_mul_ps(x2, _mm_set1_ps(28.0f));
+        den = _mm_add_ps(_mm_mul_ps(_mm_add_ps(den, _mm_set1_ps(3150.0f)), x2), _mm_set1_ps(62370.0f));
+        den = _mm_add_ps(_mm_mul_ps(den, x2), _mm_set1_ps(135135.0f));
+
+        const __m128 r = _mm_div_ps(num, den);
+        return _mm_or_ps(_mm_and_ps(saturated, unit), _mm_andnot_ps(saturated, r));
+    }
+   #endif
+
+    //==========================================================================
+    // AVX2 (8 lanes)
+
+   #if DFAM_FASTMATH_AVX2
+    DFAM_TARGET_AVX2 inline __m256 exp2(__m256 x)
+    {
+        using namespace detail;
+        x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(-126.0f)), _mm256_set1_ps(127.0f));
+        const __m256 xi = _mm256_floor_ps(x);
+        const __m256 f = _mm256_sub_ps(x, xi);
+
+        __m256 p = _mm256_set1_ps(exp2C5);
+        p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(exp2C4));
+        p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(exp2C3));
+        p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(exp2C2));
+        p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(exp2C1));
+        p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(exp2C0));
+
+        const __m256i bits = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(xi), _mm256_set1_epi32(127)), 23);
+        return _mm256_mul_ps(p, _mm256_castsi256_ps(bits));
+    }
+
+    DFAM_TARGET_AVX2 inline __m256 sin2Pi(__m256 phase)
+    {
+        using namespace detail;
+        __m256 x = _mm256_sub_ps(phase, _mm256_floor_ps(_mm256_add_ps(phase, _mm256_set1_ps(0.5f))));
+
+        const __m256 above = _mm256_cmp_ps(x, _mm256_set1_ps(0.25f), _CMP_GT_OQ);
+        const __m256 below = _mm256_cmp_ps(x, _mm256_set1_ps(-0.25f), _CMP_LT_OQ);
+        x = _mm256_blendv_ps(x, _mm256_sub_ps(_mm256_set1_ps(0.5f), x), above);
+        x = _mm256_blendv_ps(x, _mm256_sub_ps(_mm256_set1_ps(-0.5f), x), below);
+
+        const __m256 x2 = _mm256_mul_ps(x, x);
+        __m256 p = _mm256_set1_ps(sinC4);
+        p = _mm256_add_ps(_mm256_mul_ps(p, x2), _mm256_set1_ps(sinC3));
+        p = _mm256_add_ps(_mm256_mul_ps(p, x2), _mm256_set1_ps(sinC2));
+        p = _mm256_add_ps(_mm256_mul_ps(p, x2), _mm256_set1_ps(sinC1));
+        p = _mm256_add_ps(_mm256_mul_ps(p, x2), _mm256_set1_ps(sinC0));
+        return _mm256_mul_ps(p, x);
+    }
+
+    DFAM_TARGET_AVX2 inline __m256 tanh(__m256 x)
+    {
+        using namespace detail;
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        const __m256 saturated = _mm256_cmp_ps(_mm256_andnot_ps(signMask, x), _mm256_set1_ps(tanhClamp), _CMP_GT_OQ);
+        const __m256 unit = _mm256_or_ps(_mm256_and_ps(x, signMask), _mm256_set1_ps(1.0f));
+
+        const __m256 xc = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(-tanhClamp)), _mm256_set1_ps(tanhClamp));
+        const __m256 x2 = _mm256_mul_ps(xc, xc);
+        __m256 num = _mm256_add_ps(x2, _mm256_set1_ps(378.0f));
+        num = _mm256_add_ps(_mm256_mul_ps(num, x2), _mm256_set1_ps(17325.0f));
+        num = _mm256_add_ps(_mm256_mul_ps(num, x2), _mm256_set1_ps(135135.0f));
+        num = _mm256_mul_ps(num, xc);
+        __m256 den = _mm256_mul_ps(x2, _mm256_set1_ps(28.0f));
+        den = _mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(den, _mm256_set1_ps(3150.0f)), x2), _mm256_set1_ps(62370.0f));
+        den = _mm256_add_ps(_mm256_mul_ps(den, x2), _mm256_set1_ps(135135.0f));
+
+        return _mm256_blendv_ps(_mm256_div_ps(num, den), unit, saturated);
+    }
+   #endif
+
+    //==========================================================================
+    // AVX-512 (16 lanes)
+
+   #if DFAM_FASTMATH_AVX512
+    // AVX-512F implies FMA, and GCC would otherwise fuse these multiplies and adds, making
+    // the results differ from the other variants. (Older GCC 12 also warns about its own
+    // AVX-512 intrinsics once they are inlined.)
+    #if defined(__GNUC__) && !defined(__clang__)
+     #pragma GCC push_options
+     #pragma GCC optimize("fp-contract=off")
+     #pragma GCC diagnostic push
+     #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    #endif
+
+    DFAM_TARGET_AVX512 inline __m512 floor(__m512 x)
+    {
+        return _mm512_roundscale_ps(x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    }
+
+    DFAM_TARGET_AVX512 inline __m512 exp2(__m512 x)
+    {
+        using namespace detail;
+        x = _mm512_min_ps(_mm512_max_ps(x, _mm512_set1_ps(-126.0f)), _mm512_set1_ps(127.0f));
+        const __m512 xi = floor(x);
+        const __m512 f = _mm512_sub_ps(x, xi);
+
+        __m512 p = _mm512_set1_ps(exp2C5);
+        p = _mm512_add_ps(_mm512_mul_ps(p, f), _mm512_set1_ps(exp2C4));
+        p = _mm512_add_ps(_mm512_mul_ps(p, f), _mm512_set1_ps(exp2C3));
+        p = _mm512_add_ps(_mm512_mul_ps(p, f), _mm512_set1_ps(exp2C2));
+        p = _mm512_add_ps(_mm512_mul_ps(p, f), _mm512_set1_ps(exp2C1));
+        p = _mm512_add_ps(_mm512_mul_ps(p, f), _mm512_set1_ps(exp2C0));
+
+        const __m512i bits = _mm512_slli_epi32(_mm512_add_epi32(_mm512_cvttps_epi32(xi), _mm512_set1_epi32(127)), 23);
+        return _mm512_mul_ps(p, _mm512_castsi512_ps(bits));
+    }
+
+    DFAM_TARGET_AVX512 inline __m512 sin2Pi(__m512 phase)
+    {
+        using namespace detail;
+        __m512 x = _mm512_sub_ps(phase, floor(_mm512_add_ps(phase, _mm512_set1_ps(0.5f))));
+
+        const __mmask16 above = _mm512_cmp_ps_mask(x, _mm512_set1_ps(0.25f), _CMP_GT_OQ);
+        const __mmask16 below = _mm512_cmp_ps_mask(x, _mm512_set1_ps(-0.25f), _CMP_LT_OQ);
+        x = _mm512_mask_sub_ps(x, above, _mm512_set1_ps(0.5f), x);
+        x = _mm512_mask_sub_ps(x, below, _mm512_set1_ps(-0.5f), x);
+
+        const __m512 x2 = _mm512_mul_ps(x, x);
+        __m512 p = _mm512_set1_ps(sinC4);
+        p = _mm512_add_ps(_mm512_mul_ps(p, x2), _mm512_set1_ps(sinC3));
+        p = _mm512_add_ps(_mm512_mul_ps(p, x2), _mm512_set1_ps(sinC2));
+        p = _mm512_add_ps(_mm512_mul_ps(p, x2), _mm512_set1_ps(sinC1));
+        p = _mm512_add_ps(_mm512_mul_ps(p, x2), _mm512_set1_ps(sinC0));
+        return _mm512_mul_ps(p, x);
+    }
+
+    DFAM_TARGET_AVX512 inline __m512 tanh(__m512 x)
+    {
+        using namespace detail;
+        // Sign bit handling on the integer side (float and/or need AVX512DQ)
+        const __m512i bits = _mm512_castps_si512(x);
+        const __m512i signBit = _mm512_set1_epi32(static_cast<int>(0x80000000u));
+        const __m512 magnitude = _mm512_castsi512_ps(_mm512_andnot_si512(signBit, bits));
+        const __mmask16 saturated = _mm512_cmp_ps_mask(magnitude, _mm512_set1_ps(tanhClamp), _CMP_GT_OQ);
+        const __m512 unit = _mm512_castsi512_ps(_mm512_or_si512(_mm512_and_si512(bits, signBit),
+                                                                _mm512_castps_si512(_mm512_set1_ps(1.0f))));
+
+        const __m512 xc = _mm512_min_ps(_mm512_max_ps(x, _mm512_set1_ps(-tanhClamp)), _mm512_set1_ps(tanhClamp));
+        const __m512 x2 = _mm512_mul_ps(xc, xc);
+        __m512 num = _mm512_add_ps(x2, _mm512_set1_ps(378.0f));
+        num = _mm512_add_ps(_mm512_mul_ps(num, x2), _mm512_set1_ps(17325.0f));
+        num = _mm512_add_ps(_mm512_mul_ps(num, x2), _mm512_set1_ps(135135.0f));
+        num = _mm512_mul_ps(num, xc);
+        __m512 den = _mm512_mul_ps(x2, _mm512_set1_ps(28.0f));
+        den = _mm512_add_ps(_mm512_mul_ps(_mm512_add_ps(den, _mm512_set1_ps(3150.0f)), x2), _mm512_set1_ps(62370.0f));
+        den = _mm512_add_ps(_mm512_mul_ps(den, x2), _mm512_set1_ps(135135.0f));
+
+        return _mm512_mask_blend_ps(saturated, _mm512_div_ps(num, den), unit);
+    }
+
+    // Block versions. These stay in this section so they inline the functions above under
+    // the same options; the tail is a masked vector rather than scalar code.
+    #define DFAM_FASTMATH_BLOCK_AVX512(name) \
+        DFAM_TARGET_AVX512 inline void name##BlockAvx512(const float* input, float* output, int numSamples) \
+        { \
+            int i = 0; \
+            for (; i + 16 <= numSamples; i += 16) \
+                _mm512_storeu_ps(output + i, name(_mm512_loadu_ps(input + i))); \
+            if (i < numSamples) \
+            { \
+                const __mmask16 tail = static_cast<__mmask16>((1u << (numSamples - i)) - 1u); \
+                _mm512_mask_storeu_ps(output + i, tail, name(_mm512_maskz_loadu_ps(tail, input + i))); \
+            } \
+        }
+
+    DFAM_FASTMATH_BLOCK_AVX512(exp2)
+    DFAM_FASTMATH_BLOCK_AVX512(sin2Pi)
+    DFAM_FASTMATH_BLOCK_AVX512(tanh)
+
+    #undef DFAM_FASTMATH_BLOCK_AVX512
+
+    #if defined(__GNUC__) && !defined(__clang__)
+     #pragma GCC diagnostic pop
+     #pragma GCC pop_options
+    #endif
+   #endif
+
+    //==========================================================================
+    // Block versions (in-place allowed). Each instruction set gets its own (AVX-512's are
+    // above), and exp2Block runs the one SimdDispatch picked for this CPU. The sines and
+    // tanh are called per sample or per vector inside the oscillators' and filter's loops,
+    // so their block versions are only there for FastMathTests to check every variant.
+
+    #define DFAM_FASTMATH_BLOCK(name, variant, target, width, load, store) \
+        target inline void name##Block##variant(const float* input, float* output, int numSamples) \
+        { \
+            int i = 0; \
+            for (; i + width <= numSamples; i += width) \
+                store(output + i, name(load(input + i))); \
+            for (; i < numSamples; ++i) \
+                output[i] = name(input[i]); \
+        }
+
+    #define DFAM_FASTMATH_BLOCK_VARIANTS(name) \
+        inline void name##BlockScalar(const float* input, float* output, int numSamples) \
+        { \
+            for (int i = 0; i < numSamples; ++i) \
+                output[i] = name(input[i]); \
+        } \
+        DFAM_FASTMATH_BLOCK_SSE2(name) \
+        DFAM_FASTMATH_BLOCK_AVX2(name)
+
+   #if DFAM_FASTMATH_SSE2
+    #define DFAM_FASTMATH_BLOCK_SSE2(name) DFAM_FASTMATH_BLOCK(name, Sse2, , 4, _mm_loadu_ps, _mm_storeu_ps)
+   #else
+    #define DFAM_FASTMATH_BLOCK_SSE2(name)
+   #endif
+
+   #if DFAM_FASTMATH_AVX2
+    #define DFAM_FASTMATH_BLOCK_AVX2(name) DFAM_FASTMATH_BLOCK(name, Avx2, DFAM_TARGET_AVX2, 8, _mm256_loadu_ps, _mm256_storeu_ps)
+   #else
+    #define DFAM_FASTMATH_BLOCK_AVX2(name)
+   #endif
+
+    DFAM_FASTMATH_BLOCK_VARIANTS(exp2)
+    DFAM_FASTMATH_BLOCK_VARIANTS(sin2Pi)
+    DFAM_FASTMATH_BLOCK_VARIANTS(tanh)
+
+    inline void exp2Block(const float* input, float* output, int numSamples)
+    {
+        SimdDispatch::getKernels().exp2Block(input, output, numSamples);
+    }
+
+    #undef DFAM_FASTMATH_BLOCK
+    #undef DFAM_FASTMATH_BLOCK_VARIANTS
+    #undef DFAM_FASTMATH_BLOCK_SSE2
+    #undef DFAM_FASTMATH_BLOCK_AVX2
+}
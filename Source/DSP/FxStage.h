@@ -0,0 +1,137 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+// Enable state and tail tracking for one effect of the FX chain, which is processed a block
+// at a time in place.
+//
+// A disabled stage isn't processed at all. Its effect state is then stale, so the first
+// block after enabling clears the effect first (rather than replaying whatever was left in
+// it). When enabled mid-stream it fades in: the effect's input ramps up from silence while
+// the dry signal makes up the rest, so neither the jump in the mix nor the first echoes of
+// a sustained input click.
+//
+// An enabled stage runs while it has input or its tail is still sounding. Once its input
+// and output have stayed below SILENCE_THRESHOLD for the tail hold (its longest internal
+// delay, so a gap between echoes isn't taken for the end) it idles, costing a silence check
+// per block, until the input comes back.
+class FxStage
+{
+public:
+    static constexpr float SILENCE_THRESHOLD = 1.0e-5f;  // -100 dB
+
+    // fadeStorage holds 2 * maxBlockSize floats for the dry signal. It's only used within
+    // process(), so the stages of a chain can share it.
+    void prepare(double sampleRate, int maxBlockSize, float* fadeStorage)
+    {
+        fadeLength = std::max(1, static_cast<int>(sampleRate * 0.005));  // 5 ms
+        dryLeft = fadeStorage;
+        dryRight = fadeStorage + maxBlockSize;
+        stale = true;
+        started = false;
+        running = false;
+    }
+
+    void setEnabled(bool shouldBeEnabled)
+    {
+        if (!shouldBeEnabled)
+            stale = true;
+        enabled = shouldBeEnabled;
+    }
+
+    void setTailHold(int numSamples) { tailHold = numSamples; }
+    int getTailHold() const { return tailHold; }
+
+    bool isEnabled() const { return enabled; }
+
+    // Whether the last block ran the effect (false while disabled or idle)
+    bool isRunning() const { return running; }
+
+    // One block (right is null for mono): processEffect(left, right, numSamples) runs the
+    // effect in place, resetEffect() clears it. Call it for every block, enabled or not, so
+    // an enable mid-stream is told apart from one before the first block.
+    template <typename Process, typename Reset>
+    void process(float* left, float* right, int numSamples, Process&& processEffect, Reset&& resetEffect)
+    {
+        running = false;
+        const bool midStream = std::exchange(started, true);
+        if (!enabled)
+            return;
+
+        if (stale)
+        {
+            resetEffect();
+            stale = false;
+            fadePosition = midStream ? 0 : fadeLength;
+            silentSamples = tailHold;  // nothing left ringing
+        }
+
+        const bool inputSilent = isSilent(left, right, numSamples);
+        if (silentSamples >= tailHold && inputSilent)
+            return;
+
+        const bool fading = fadePosition < fadeLength;
+        if (fading)
+        {
+            splitForFade(left, dryLeft, numSamples);
+            if (right != nullptr)
+                splitForFade(right, dryRight, numSamples);
+        }
+
+        processEffect(left, right, numSamples);
+        running = true;
+
+        if (fading)
+        {
+            juce::FloatVectorOperations::add(left, dryLeft, numSamples);
+            if (right != nullptr)
+                juce::FloatVectorOperations::add(right, dryRight, numSamples);
+            fadePosition = std::min(fadePosition + numSamples, fadeLength);
+        }
+
+        if (inputSilent && isSilent(left, right, numSamples))
+            silentSamples = std::min(silentSamples + numSamples, tailHold);
+        else
+            silentSamples = 0;
+    }
+
+private:
+    bool enabled = false;
+    bool stale = true;     // effect state left over from before it was disabled
+    bool started = false;  // a block has passed since prepare()
+    bool running = false;
+    int tailHold = 0;
+    int silentSamples = 0;
+
+    int fadeLength = 1;
+    int fadePosition = 0;
+    float* dryLeft = nullptr;
+    float* dryRight = nullptr;
+
+    // Split the signal into the effect's share (the fade-in ramp, continued from
+    // fadePosition) and the dry remainder
+    void splitForFade(float* samples, float* dry, int numSamples) const
+    {
+        const float step = 1.0f / static_cast<float>(fadeLength);
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float gain = std::min(static_cast<float>(fadePosition + i) * step, 1.0f);
+            dry[i] = samples[i] * (1.0f - gain);
+            samples[i] *= gain;
+        }
+    }
+
+    static bool isSilent(const float* left, const float* right, int numSamples)
+    {
+        float peak = 0.0f;
+        for (int i = 0; i < numSamples; ++i)
+            peak = std::max(peak, std::abs(left[i]));
+        if (right != nullptr)
+            for (int i = 0; i < numSamples; ++i)
+                peak = std::max(peak, std::abs(right[i]));
+        return peak < SILENCE_THRESHOLD;
+    }
+};
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <cstddef>
+#include "FastMath.h"
+
+// Polyphase IIR half-band filter for halving or doubling the sample rate of one or two
+// channels.
+//
+// Two chains of first-order allpasses, one per polyphase branch, both running at the lower
+// rate (the structure of Laurent de Soras' HIIR). The four coefficients give a passband up
+// to 0.2 and a stopband from 0.3 of the higher rate, 70 dB down. The phase isn't linear,
+// which a reverb doesn't mind.
+//
+// The chains are recursive, so rather than across samples the SIMD lanes run across them:
+// {channel 0 branch 0, channel 0 branch 1, channel 1 branch 0, channel 1 branch 1}, each
+// lane taking two allpasses. An instance keeps the state of one direction: use separate
+// ones for down and up.
+template <int numChannels>
+class HalfBandFilter
+{
+    static_assert(numChannels == 1 || numChannels == 2, "two channels fill the lanes");
+
+public:
+    void reset()
+    {
+        for (auto& stage : stages)
+        {
+            stage.inputs.fill(0.0f);
+            stage.outputs.fill(0.0f);
+        }
+    }
+
+    // numOutput samples per channel from 2 * numOutput inputs; may run in place
+    void downsample(const float* const* input, float* const* output, int numOutput)
+    {
+        const float* const in1 = input[numChannels - 1];  // mono runs channel 0 in both halves
+
+       #if DFAM_FASTMATH_SSE2
+        LaneStage first = load(0);
+        LaneStage second = load(1);
+        for (int i = 0; i < numOutput; ++i)
+        {
+            // Branch 0 takes the odd input samples, branch 1 the even ones
+            __m128 x = _mm_setr_ps(input[0][2 * i + 1], input[0][2 * i], in1[2 * i + 1], in1[2 * i]);
+            x = second.process(first.process(x));
+
+            const __m128 sums = _mm_mul_ps(_mm_add_ps(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1))), _mm_set1_ps(0.5f));
+            output[0][i] = _mm_cvtss_f32(sums);
+            if constexpr (numChannels == 2)
+                output[1][i] = _mm_cvtss_f32(_mm_movehl_ps(sums, sums));
+        }
+        store(0, first);
+        store(1, second);
+       #else
+        for (int i = 0; i < numOutput; ++i)
+        {
+            std::array<float, 4> x = { input[0][2 * i + 1], input[0][2 * i], in1[2 * i + 1], in1[2 * i] };
+            process(x);
+            output[0][i] = 0.5f * (x[0] + x[1]);
+            if constexpr (numChannels == 2)
+                output[1][i] = 0.5f * (x[2] + x[3]);
+        }
+       #endif
+    }
+
+    // Delay of downsample() at low frequencies, in samples of the lower rate, taking input
+    // sample 2i to line up with output sample i. Each branch's first-order allpasses delay
+    // DC by (1 - c) / (1 + c) lower-rate samples, and the output averages the two branches,
+    // which start half a lower-rate sample apart.
+    static double getDownsampleDelay()
+    {
+        double delay = 0.0;
+        for (const auto& stage : COEFFS)
+            delay += ((1.0 - stage[0]) / (1.0 + stage[0]) + (1.0 - stage[1]) / (1.0 + stage[1])) * 0.5;
+        return delay - 0.25;
+    }
+
+    // 2 * numInput samples per channel from numInput inputs; not in place
+    void upsample(const float* const* input, float* const* output, int numInput)
+    {
+        const float* const in1 = input[numChannels - 1];
+
+       #if DFAM_FASTMATH_SSE2
+        LaneStage first = load(0);
+        LaneStage second = load(1);
+        for (int i = 0; i < numInput; ++i)
+        {
+            const __m128 y = second.process(first.process(_mm_setr_ps(input[0][i], input[0][i], in1[i], in1[i])));
+            _mm_storel_pi(reinterpret_cast<__m64*>(output[0] + 2 * i), y);
+            if constexpr (numChannels == 2)
+                _mm_storeh_pi(reinterpret_cast<__m64*>(output[1] + 2 * i), y);
+        }
+        store(0, first);
+        store(1, second);
+       #else
+        for (int i = 0; i < numInput; ++i)
+        {
+            std::array<float, 4> y = { input[0][i], input[0][i], in1[i], in1[i] };
+            process(y);
+            output[0][2 * i] = y[0];
+            output[0][2 * i + 1] = y[1];
+            if constexpr (numChannels == 2)
+            {
+                output[1][2 * i] = y[2];
+                output[1][2 * i + 1] = y[3];
+            }
+        }
+       #endif
+    }
+
+private:
+    static constexpr size_t NUM_STAGES = 2;
+
+    // Elliptic design for a transition band of 0.1, per stage and lane (the branches take
+    // the coefficients alternately)
+    static constexpr std::array<std::array<float, 4>, NUM_STAGES> COEFFS = { {
+        { 0.079866426f, 0.283829345f, 0.079866426f, 0.283829345f },
+        { 0.545323651f, 0.834411891f, 0.545323651f, 0.834411891f } } };
+
+    struct Stage
+    {
+        std::array<float, 4> inputs = {};
+        std::array<float, 4> outputs = {};
+    };
+    std::array<Stage, NUM_STAGES> stages;
+
+    // First-order allpasses in the lower rate's delay, written so only a multiply and a
+    // subtract wait on the previous output: y = (c * x + x1) - c * y1
+
+   #if DFAM_FASTMATH_SSE2
+    // A stage's working copy, kept in registers for the length of a loop
+    struct LaneStage
+    {
+        __m128 coeffs, input, output;
+
+        JUCE_FORCEINLINE __m128 process(__m128 x)
+        {
+            const __m128 y = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(coeffs, x), input), _mm_mul_ps(coeffs, output));
+            input = x;
+            output = y;
+            return y;
+        }
+    };
+
+    LaneStage load(size_t stage) const
+    {
+        return { _mm_loadu_ps(COEFFS[stage].data()), _mm_loadu_ps(stages[stage].inputs.data()),
+                 _mm_loadu_ps(stages[stage].outputs.data()) };
+    }
+
+    void store(size_t stage, const LaneStage& s)
+    {
+        _mm_storeu_ps(stages[stage].inputs.data(), s.input);
+        _mm_storeu_ps(stages[stage].outputs.data(), s.output);
+    }
+   #else
+    void process(std::array<float, 4>& x)
+    {
+        for (size_t s = 0; s < NUM_STAGES; ++s)
+        {
+            for (size_t lane = 0; lane < 4; ++lane)
+            {
+                const float c = COEFFS[s][lane];
+                const float y = (c * x[lane] + stages[s].inputs[lane]) - c * stages[s].outputs[lane];
+                stages[s].inputs[lane] = x[lane];
+                stages[s].outputs[lane] = y;
+                x[lane] = y;
+            }
+        }
+    }
+   #endif
+};
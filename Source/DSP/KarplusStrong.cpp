@@ -0,0 +1,141 @@
+#include "KarplusStrong.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr float BASE_FREQUENCY = 65.41f;  // C2
+    constexpr float MAX_DELAY_SECONDS = 2.1f;  // delay time slider plus the lowest step pitch
+
+    // Multi-string detune in cents, first string at pitch
+    constexpr std::array<float, KarplusStrong::MAX_STRINGS> STRING_DETUNE_CENTS = { 0.0f, 7.0f, -7.0f };
+}
+
+int KarplusStrong::getRequiredStorage(double sampleRate)
+{
+    return MAX_STRINGS * DelayLine<float>::getBufferSize(static_cast<int>(sampleRate * MAX_DELAY_SECONDS));
+}
+
+void KarplusStrong::prepare(double newSampleRate, float* storage)
+{
+    sampleRate = newSampleRate;
+
+    const int lineSize = DelayLine<float>::getBufferSize(static_cast<int>(sampleRate * MAX_DELAY_SECONDS));
+    for (auto& string : strings)
+    {
+        string.line.setBuffer(storage, lineSize);
+        storage += lineSize;
+    }
+
+    reset();
+    updateDelays();
+}
+
+void KarplusStrong::reset()
+{
+    for (auto& string : strings)
+    {
+        string.line.reset();
+        string.lossState = 0.0f;
+    }
+}
+
+void KarplusStrong::setStepPitches(const std::array<float, NUM_STEPS>& semitones)
+{
+    if (semitones == stepPitches)
+        return;
+
+    stepPitches = semitones;
+    updateDelays();
+}
+
+void KarplusStrong::setDelayTime(float seconds)
+{
+    if (seconds == delayTime)
+        return;
+
+    delayTime = seconds;
+    updateDelays();
+}
+
+void KarplusStrong::setLossFilter(float coefficient)
+{
+    if (coefficient == lossCoeff)
+        return;
+
+    lossCoeff = coefficient;
+    updateDelays();
+}
+
+void KarplusStrong::setMultiString(bool shouldUseMultiString)
+{
+    const int newNumStrings = shouldUseMultiString ? MAX_STRINGS : 1;
+    if (newNumStrings == numStrings)
+        return;
+
+    // Strings that join start silent rather than replaying stale loop contents
+    for (int s = numStrings; s < newNumStrings; ++s)
+    {
+        strings[static_cast<size_t>(s)].line.reset();
+        strings[static_cast<size_t>(s)].lossState = 0.0f;
+    }
+
+    numStrings = newNumStrings;
+}
+
+void KarplusStrong::updateDelays()
+{
+    const float maxDelay = static_cast<float>(strings[0].line.getMaxDelay() - 1);
+    const float extraSamples = delayTime * static_cast<float>(sampleRate);
+    longestDelay = 0;
+
+    for (int step = 0; step < NUM_STEPS; ++step)
+    {
+        for (int s = 0; s < MAX_STRINGS; ++s)
+        {
+            const float semitones = stepPitches[static_cast<size_t>(step)]
+                                    + STRING_DETUNE_CENTS[static_cast<size_t>(s)] * 0.01f;
+            const float frequency = BASE_FREQUENCY * std::pow(2.0f, semitones / 12.0f);
+            const float period = static_cast<float>(sampleRate) / frequency + extraSamples;
+
+            // The loss filter delays the loop by its phase delay at the fundamental
+            const float omega = juce::MathConstants<float>::twoPi * frequency / static_cast<float>(sampleRate);
+            const float lossDelay = omega > 0.0f && omega < juce::MathConstants<float>::pi
+                ? std::atan2(lossCoeff * std::sin(omega), 1.0f - lossCoeff * std::cos(omega)) / omega
+                : 0.0f;
+
+            const float lineDelay = juce::jlimit(2.0f, maxDelay, period - lossDelay);
+            const auto delay = DelayLine<float>::getAllpassDelay(lineDelay);
+            stepDelays[static_cast<size_t>(step)][static_cast<size_t>(s)] = delay;
+            longestDelay = std::max(longestDelay, delay.whole + 1);
+        }
+    }
+}
+
+void KarplusStrong::process(float* samples, int numSamples)
+{
+    const auto& delays = stepDelays[static_cast<size_t>(currentStep)];
+    const float wetGain = mix / static_cast<float>(numStrings);
+    const float lossInput = 1.0f - lossCoeff;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float input = samples[i];
+        float wet = 0.0f;
+
+        for (int s = 0; s < numStrings; ++s)
+        {
+            auto& string = strings[static_cast<size_t>(s)];
+
+            float delayed = string.line.readAllpass(delays[static_cast<size_t>(s)]);
+
+            // Loss filter (one-pole lowpass) in the feedback path
+            string.lossState = string.lossState * lossCoeff + delayed * lossInput;
+            string.line.push(input + string.lossState * feedback);
+
+            wet += delayed;
+        }
+
+        samples[i] = input + wet * wetGain;
+    }
+}
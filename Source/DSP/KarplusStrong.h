@@ -0,0 +1,69 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include "DelayLine.h"
+
+// Karplus-Strong resonator: a feedback delay tuned per sequencer step, with a one-pole
+// loss filter in the loop.
+//
+// Loop lengths are computed once per change of the step pitches, delay time or loss
+// filter, not per sample. Each length is corrected for the loss filter's phase delay at
+// the string's fundamental and read through an allpass fractional delay, so the loop
+// resonates at the requested pitch even at short delays. In multi-string mode each step
+// drives three strings detuned around the pitch.
+class KarplusStrong
+{
+public:
+    static constexpr int NUM_STEPS = 8;
+    static constexpr int MAX_STRINGS = 3;
+
+    // Floats of storage prepare() needs: one delay line per string
+    static int getRequiredStorage(double sampleRate);
+
+    // storage holds getRequiredStorage(sampleRate) floats; clears the strings
+    void prepare(double sampleRate, float* storage);
+    void reset();
+
+    // Loop settings. Each setter only recomputes the step delays if its value changed.
+    void setStepPitches(const std::array<float, NUM_STEPS>& semitones);  // relative to C2
+    void setDelayTime(float seconds);   // extra loop time on top of the tuned period
+    void setLossFilter(float coefficient);  // one-pole lowpass coefficient (0 = no loss)
+    void setMultiString(bool shouldUseMultiString);
+
+    void setFeedback(float newFeedback) { feedback = newFeedback; }
+    void setMix(float newMix) { mix = newMix; }
+    void setStep(int step) { currentStep = juce::jlimit(0, NUM_STEPS - 1, step); }
+
+    // In place: adds the resonator output to the signal and feeds the signal into the strings
+    void process(float* samples, int numSamples);
+
+    // Longest loop over all steps and strings, in samples: how long the output can go quiet
+    // between echoes
+    int getLongestDelay() const { return longestDelay; }
+
+private:
+    using Delay = DelayLine<float>::AllpassDelay;
+
+    struct String
+    {
+        DelayLine<float> line;
+        float lossState = 0.0f;
+    };
+
+    double sampleRate = 44100.0;
+    std::array<String, MAX_STRINGS> strings;
+    int numStrings = 1;
+
+    std::array<float, NUM_STEPS> stepPitches = {};
+    float delayTime = 0.0f;
+    float lossCoeff = 0.0f;
+    float feedback = 0.0f;
+    float mix = 0.0f;
+    int currentStep = 0;
+
+    std::array<std::array<Delay, MAX_STRINGS>, NUM_STEPS> stepDelays = {};
+    int longestDelay = 0;
+
+    void updateDelays();
+};
@@ -1,4 +1,5 @@
 #include "LadderFilter.h"
+#include "FastMath.h"
 #include <cmath>
 #include <algorithm>
 
@@ -48,6 +49,50 @@ float LadderFilter::process(float input)
     // Soft clip the input to prevent runaway with high resonance
     u = std::tanh(u);
 
+    return filterMode == Mode::Highpass ? processStages<Mode::Highpass>(input, u)
+                                        : processStages<Mode::Lowpass>(input, u);
+}
+
+void LadderFilter::processBlock(const float* input, const float* cutoffHz, const float* res,
+                                float* output, int numSamples)
+{
+    // The mode is fixed for the block, so pick a loop compiled for it
+    if (filterMode == Mode::Highpass)
+        processBlockWithMode<Mode::Highpass>(input, cutoffHz, res, output, numSamples);
+    else
+        processBlockWithMode<Mode::Lowpass>(input, cutoffHz, res, output, numSamples);
+}
+
+template <LadderFilter::Mode mode>
+void LadderFilter::processBlockWithMode(const float* input, const float* cutoffHz, const float* res,
+                                        float* output, int numSamples)
+{
+    const float invSampleRate = 1.0f / static_cast<float>(sampleRate);
+    const float maxCutoff = static_cast<float>(sampleRate * 0.45);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // g = tan(pi * fc) / (1 + tan(pi * fc)), written as sin / (sin + cos) so it has
+        // no pole inside the usable range
+        float halfFc = 0.5f * std::min(std::clamp(cutoffHz[i], 20.0f, maxCutoff) * invSampleRate, 0.45f);
+        float s = FastMath::sin2Pi(halfFc);
+        g = s / (s + FastMath::cos2Pi(halfFc));
+        k = std::clamp(res[i], 0.0f, 1.0f) * 3.6f;
+
+        float u = FastMath::tanh(input[i] - stage[3] * k);
+        output[i] = processStages<mode>(input[i], u);
+    }
+
+    if (numSamples > 0)
+    {
+        cutoff = std::clamp(cutoffHz[numSamples - 1], 20.0f, maxCutoff);
+        resonance = std::clamp(res[numSamples - 1], 0.0f, 1.0f);
+    }
+}
+
+template <LadderFilter::Mode mode>
+float LadderFilter::processStages(float input, float u)
+{
     // Four cascaded one-pole lowpass filters
     // Using TPT (topology-preserving transform) style integration
     for (int i = 0; i < 4; ++i)
@@ -60,7 +105,7 @@ float LadderFilter::process(float input)
 
     float lpOutput = stage[3];
 
-    if (filterMode == Mode::Highpass)
+    if constexpr (mode == Mode::Highpass)
     {
         // Highpass = input - lowpass
         float hpOutput = input - lpOutput;
@@ -19,6 +19,12 @@ public:
 
     float process(float input);
 
+    // Process a block with per-sample cutoff (Hz) and resonance (0-1) arrays.
+    // Coefficients and the feedback saturation use FastMath instead of std::tan/std::tanh,
+    // so audio-rate cutoff modulation stays cheap.
+    void processBlock(const float* input, const float* cutoffHz, const float* res,
+                      float* output, int numSamples);
+
 private:
     double sampleRate = 44100.0;
     float cutoff = 1000.0f;
@@ -36,4 +42,11 @@ private:
     float k = 0.0f;  // resonance coefficient
 
     void updateCoefficients();
+
+    template <Mode mode>
+    void processBlockWithMode(const float* input, const float* cutoffHz, const float* res,
+                              float* output, int numSamples);
+
+    template <Mode mode>
+    float processStages(float input, float u);
 };
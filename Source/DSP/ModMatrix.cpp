@@ -0,0 +1,65 @@
+#include "ModMatrix.h"
+
+namespace
+{
+    // Scaling from a slot's -1..+1 output into each destination's units
+    constexpr std::array<float, ModMatrix::NUM_DESTINATIONS> destinationScales = {
+        1.0f,   // Filter Cutoff (octaves)
+        1.0f,   // Filter Resonance
+        12.0f,  // VCO1 Pitch (±12 semitones)
+        12.0f,  // VCO2 Pitch
+        1.0f,   // Ring Freq
+        1.0f,   // Pan
+        0.5f,   // VCO1 Level
+        0.5f,   // VCO2 Level
+        1.0f,   // VCA Decay
+        1.0f,   // Noise VCF Mod
+        1.0f,   // VCF Decay
+        0.5f    // FM Amount
+    };
+}
+
+void ModMatrix::setSlots(const std::array<Slot, NUM_SLOTS>& newSlots)
+{
+    if (newSlots == slots)
+        return;
+
+    slots = newSlots;
+    compile();
+}
+
+void ModMatrix::compile()
+{
+    numRoutes = 0;
+    sourceUsed.fill(false);
+
+    // Routes keep slot order, so slots sharing a destination sum in the same order as before
+    for (const auto& slot : slots)
+    {
+        if (slot.source <= 0 || slot.source > NUM_SOURCES
+            || slot.destination <= 0 || slot.destination > NUM_DESTINATIONS
+            || slot.amount == 0.0f)
+            continue;  // OFF, out of range, or silent
+
+        auto& route = routes[static_cast<size_t>(numRoutes++)];
+        route.source = slot.source - 1;
+        route.destination = slot.destination - 1;
+        route.gain = slot.amount * destinationScales[static_cast<size_t>(route.destination)];
+
+        sourceUsed[static_cast<size_t>(route.source)] = true;
+    }
+}
+
+void ModMatrix::processBlock(const float* const* sourceBuffers, float* const* destinationBuffers,
+                             int numSamples) const
+{
+    for (int d = 0; d < NUM_DESTINATIONS; ++d)
+        juce::FloatVectorOperations::clear(destinationBuffers[d], numSamples);
+
+    for (int r = 0; r < numRoutes; ++r)
+    {
+        const auto& route = routes[static_cast<size_t>(r)];
+        juce::FloatVectorOperations::addWithMultiply(destinationBuffers[route.destination],
+                                                     sourceBuffers[route.source], route.gain, numSamples);
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+// Patch bay between the modulation sources and destinations.
+//
+// Whenever a slot changes, the active slots are compiled into a flat table of routes
+// (source index, destination index, gain with the destination's scaling folded in). OFF
+// slots never reach the table, so the cost follows the number of routes rather than the
+// number of slots. Blocks are processed route by route as a vectorised multiply-add over
+// contiguous sample buffers.
+class ModMatrix
+{
+public:
+    static constexpr int NUM_SLOTS = 16;
+
+    // Source parameter value - 1
+    enum Source
+    {
+        Lfo, PitchEnv, FilterEnv, VcaEnv, Velocity, Random,
+        NUM_SOURCES
+    };
+
+    // Destination parameter value - 1
+    enum Destination
+    {
+        FilterCutoff, FilterRes, Vco1Pitch, Vco2Pitch, RingFreq, Pan,
+        Vco1Level, Vco2Level, VcaDecay, NoiseVcfMod, VcfDecay, FmAmount,
+        NUM_DESTINATIONS
+    };
+
+    using Sources = std::array<float, NUM_SOURCES>;  // each -1 to +1
+    using Values = std::array<float, NUM_DESTINATIONS>;
+
+    // Slot settings as stored in the parameters: 0 = OFF, otherwise enum value + 1
+    struct Slot
+    {
+        int source = 0;
+        int destination = 0;
+        float amount = 0.0f;
+
+        bool operator==(const Slot& other) const
+        {
+            return source == other.source && destination == other.destination && amount == other.amount;
+        }
+        bool operator!=(const Slot& other) const { return !(*this == other); }
+    };
+
+    // Recompile the route table if any slot changed
+    void setSlots(const std::array<Slot, NUM_SLOTS>& newSlots);
+
+    bool usesSource(Source source) const { return sourceUsed[static_cast<size_t>(source)]; }
+    int getNumRoutes() const { return numRoutes; }
+
+    // Evaluate one point
+    void process(const Sources& sources, Values& values) const
+    {
+        values.fill(0.0f);
+
+        for (int r = 0; r < numRoutes; ++r)
+        {
+            const auto& route = routes[static_cast<size_t>(r)];
+            values[static_cast<size_t>(route.destination)] += sources[static_cast<size_t>(route.source)] * route.gain;
+        }
+    }
+
+    // Evaluate numSamples points. sourceBuffers[s] is only read for sources in use;
+    // every destination buffer is written.
+    void processBlock(const float* const* sourceBuffers, float* const* destinationBuffers, int numSamples) const;
+
+private:
+    struct Route
+    {
+        int source = 0;
+        int destination = 0;
+        float gain = 0.0f;
+    };
+
+    std::array<Slot, NUM_SLOTS> slots = {};
+    std::array<Route, NUM_SLOTS> routes = {};
+    int numRoutes = 0;
+    std::array<bool, NUM_SOURCES> sourceUsed = {};
+
+    void compile();
+};
@@ -0,0 +1,74 @@
+#include "MorphWavetable.h"
+#include <cmath>
+#include <algorithm>
+
+namespace
+{
+    // The naive waveform is sampled 4x denser than the table before band-limiting,
+    // so harmonics above the table's range don't fold back into it
+    constexpr int BUILD_OVERSAMPLING = 4;
+    constexpr int MAX_HARMONIC = 1024;
+}
+
+MorphWavetable::MorphWavetable(int rows, const std::function<float(int, double)>& generator)
+    : numRows(std::max(rows, 2))
+{
+    table.resize(static_cast<size_t>(NUM_LEVELS * numRows * ROW_STRIDE), 0.0f);
+
+    for (int row = 0; row < numRows; ++row)
+        buildRow(row, generator);
+}
+
+void MorphWavetable::buildRow(int row, const std::function<float(int, double)>& generator)
+{
+    const int buildSize = TABLE_SIZE * BUILD_OVERSAMPLING;
+    juce::dsp::FFT fft(static_cast<int>(std::log2(buildSize)));
+
+    std::vector<float> spectrum(static_cast<size_t>(buildSize * 2), 0.0f);
+    for (int i = 0; i < buildSize; ++i)
+        spectrum[static_cast<size_t>(i)] = generator(std::min(row, numRows - 1), static_cast<double>(i) / buildSize);
+
+    fft.performRealOnlyForwardTransform(spectrum.data(), true);
+
+    std::vector<float> work(spectrum.size());
+    for (int level = 0; level < NUM_LEVELS; ++level)
+    {
+        // Keep DC and harmonics up to this level's limit, drop everything above
+        const int maxHarmonic = MAX_HARMONIC >> level;
+        std::fill(work.begin(), work.end(), 0.0f);
+        std::copy(spectrum.begin(), spectrum.begin() + 2 * (maxHarmonic + 1), work.begin());
+
+        fft.performRealOnlyInverseTransform(work.data());
+
+        float* dest = table.data() + (static_cast<size_t>(level * numRows + row)) * ROW_STRIDE;
+        for (int i = 0; i < TABLE_SIZE; ++i)
+            dest[i] = work[static_cast<size_t>(i * BUILD_OVERSAMPLING)];
+        dest[TABLE_SIZE] = dest[0];
+    }
+}
+
+int MorphWavetable::getLevelForIncrement(double increment)
+{
+    // Need (MAX_HARMONIC >> level) * increment <= 0.5, i.e. level >= log2(2 * MAX_HARMONIC * increment)
+    int exponent = 0;
+    std::frexp(2.0 * MAX_HARMONIC * std::abs(increment), &exponent);
+    return std::clamp(exponent, 0, NUM_LEVELS - 1);
+}
+
+float MorphWavetable::lookup(int level, float rowPosition, double phase) const
+{
+    const float clampedRow = std::clamp(rowPosition, 0.0f, static_cast<float>(numRows - 1));
+    const int row = std::min(static_cast<int>(clampedRow), numRows - 2);
+    const float rowFrac = clampedRow - static_cast<float>(row);
+
+    const double index = phase * TABLE_SIZE;
+    const int i = std::clamp(static_cast<int>(index), 0, TABLE_SIZE - 1);
+    const float frac = static_cast<float>(index - i);
+
+    const float* rowA = table.data() + (static_cast<size_t>(level * numRows + row)) * ROW_STRIDE;
+    const float* rowB = rowA + ROW_STRIDE;
+
+    const float a = rowA[i] + (rowA[i + 1] - rowA[i]) * frac;
+    const float b = rowB[i] + (rowB[i + 1] - rowB[i]) * frac;
+    return a + (b - a) * rowFrac;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <vector>
+
+// Band-limited 2D wavetable: rows along a morph axis x one cycle of phase, with one mip
+// level per octave. Built once from a waveform generator and then only read, so a single
+// instance can be shared by every oscillator in the process.
+class MorphWavetable
+{
+public:
+    static constexpr int TABLE_SIZE = 4096;   // samples per cycle
+    static constexpr int NUM_LEVELS = 11;     // level n keeps harmonics up to 1024 >> n
+
+    // generator(row, phase) returns the naive waveform for a row at phase 0-1
+    MorphWavetable(int numRows, const std::function<float(int, double)>& generator);
+
+    int getNumRows() const { return numRows; }
+
+    // Lowest mip level whose harmonics all stay below Nyquist at this phase increment
+    static int getLevelForIncrement(double increment);
+
+    // Bilinear lookup: rowPosition 0 to numRows-1 (fractional blends rows), phase 0 to 1
+    float lookup(int level, float rowPosition, double phase) const;
+
+private:
+    static constexpr int ROW_STRIDE = TABLE_SIZE + 1;  // one guard sample for interpolation
+
+    int numRows = 0;
+    std::vector<float> table;  // [level][row][ROW_STRIDE]
+
+    void buildRow(int row, const std::function<float(int, double)>& generator);
+};
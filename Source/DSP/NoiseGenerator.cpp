@@ -1,18 +1,26 @@
 #include "NoiseGenerator.h"
 
 NoiseGenerator::NoiseGenerator()
-    : rng(std::random_device{}())
-    , distribution(-1.0f, 1.0f)
 {
 }
 
 void NoiseGenerator::prepare(double /*sampleRate*/)
 {
-    // Reseed for consistent behavior
-    rng.seed(std::random_device{}());
+    // Restart the sequence for consistent behavior
+    rng.reset();
+}
+
+void NoiseGenerator::setSeed(uint32_t seed, uint32_t streamId)
+{
+    rng.setSeed(seed, streamId);
 }
 
 float NoiseGenerator::process()
 {
-    return distribution(rng);
+    return rng.nextBipolar();
+}
+
+void NoiseGenerator::process(float* output, int numSamples)
+{
+    rng.fillBipolar(output, numSamples);
 }
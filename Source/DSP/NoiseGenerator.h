@@ -1,7 +1,7 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include <random>
+#include "RandomStream.h"
 
 class NoiseGenerator
 {
@@ -10,10 +10,15 @@ public:
 
     void prepare(double sampleRate);
 
+    // Seed of the noise sequence; prepare() restarts it, so renders are repeatable
+    void setSeed(uint32_t seed, uint32_t streamId);
+
     // Get next noise sample (-1 to 1)
     float process();
 
+    // Next numSamples noise samples
+    void process(float* output, int numSamples);
+
 private:
-    std::mt19937 rng;
-    std::uniform_real_distribution<float> distribution;
+    RandomStream rng;
 };
@@ -1,139 +1,63 @@
 #include "Oscillator.h"
+#include "FastMath.h"
 #include <cmath>
 
-Oscillator::Oscillator()
+const MorphWavetable& Oscillator::getSharedWavetable()
 {
-}
-
-void Oscillator::prepare(double newSampleRate)
-{
-    sampleRate = newSampleRate;
-    phase = 0.0;
-    completedCycle = false;
-    updatePhaseIncrement();
-}
-
-void Oscillator::setFrequency(float newFrequency)
-{
-    frequency = newFrequency;
-    updatePhaseIncrement();
-}
-
-void Oscillator::setWaveformPosition(float position)
-{
-    waveformPosition = std::clamp(position, 0.0f, 1.0f);
-}
-
-float Oscillator::process()
-{
-    completedCycle = false;
-    float output = generateMorphedWaveform();
-
-    phase += phaseIncrement;
-    if (phase >= 1.0)
+    static const MorphWavetable table(4, [](int row, double p)
     {
-        phase -= 1.0;
-        completedCycle = true;
-    }
-
-    return output;
+        switch (row)
+        {
+            case 0:  return generateSine(p);
+            case 1:  return generateTriangle(p);
+            case 2:  return generateSquare(p);
+            default: return generateChaos(p);
+        }
+    });
+    return table;
 }
 
-float Oscillator::process(float fmInput, float fmAmount)
+float Oscillator::generateSine(double p)
 {
-    completedCycle = false;
-
-    // Apply FM: modulate frequency by fmInput
-    // fmAmount controls the depth of modulation
-    double modulatedIncrement = phaseIncrement * (1.0 + fmInput * fmAmount * 4.0);
-
-    float output = generateMorphedWaveform();
-
-    phase += modulatedIncrement;
-    while (phase >= 1.0)
-    {
-        phase -= 1.0;
-        completedCycle = true;
-    }
-    while (phase < 0.0)
-        phase += 1.0;
-
-    return output;
+    return FastMath::sin2Pi(static_cast<float>(p));
 }
 
-float Oscillator::processWithPitchMod(float pitchModSemitones)
-{
-    completedCycle = false;
-
-    // Apply pitch modulation in semitones
-    float pitchMult = std::pow(2.0f, pitchModSemitones / 12.0f);
-    double modulatedIncrement = phaseIncrement * pitchMult;
-
-    float output = generateMorphedWaveform();
-
-    phase += modulatedIncrement;
-    while (phase >= 1.0)
-    {
-        phase -= 1.0;
-        completedCycle = true;
-    }
-    while (phase < 0.0)
-        phase += 1.0;
-
-    return output;
-}
-
-void Oscillator::sync()
-{
-    phase = 0.0;
-}
-
-void Oscillator::updatePhaseIncrement()
-{
-    phaseIncrement = frequency / sampleRate;
-}
-
-float Oscillator::generateSine() const
-{
-    return static_cast<float>(std::sin(phase * 2.0 * 3.14159265358979323846));
-}
-
-float Oscillator::generateTriangle() const
+float Oscillator::generateTriangle(double p)
 {
     // Triangle wave: ramp up from -1 to 1 in first half, down from 1 to -1 in second half
-    if (phase < 0.5)
-        return static_cast<float>(4.0 * phase - 1.0);
+    if (p < 0.5)
+        return static_cast<float>(4.0 * p - 1.0);
     else
-        return static_cast<float>(3.0 - 4.0 * phase);
+        return static_cast<float>(3.0 - 4.0 * p);
 }
 
-float Oscillator::generateSquare() const
+float Oscillator::generateSquare(double p)
 {
-    return (phase < 0.5) ? 1.0f : -1.0f;
+    return (p < 0.5) ? 1.0f : -1.0f;
 }
 
-float Oscillator::generateChaos() const
+float Oscillator::generateChaos(double phase)
 {
     // Aggressive wavetable-style waveform with wave folding and bit crushing feel
-    double p = phase * 2.0 * 3.14159265358979323846;
+    float p = static_cast<float>(phase);
 
     // Sawtooth base
     float saw = static_cast<float>(1.0 - 2.0 * phase);
 
     // Add many harmonics for rich texture
-    float h2 = static_cast<float>(std::sin(p * 2.0) * 0.7);
-    float h3 = static_cast<float>(std::sin(p * 3.0) * 0.6);
-    float h4 = static_cast<float>(std::sin(p * 4.0) * 0.5);
-    float h5 = static_cast<float>(std::sin(p * 5.0) * 0.45);
-    float h7 = static_cast<float>(std::sin(p * 7.0) * 0.35);
-    float h9 = static_cast<float>(std::sin(p * 9.0) * 0.25);
-    float h11 = static_cast<float>(std::sin(p * 11.0) * 0.2);
+    float h2 = FastMath::sin2Pi(p * 2.0f) * 0.7f;
+    float h3 = FastMath::sin2Pi(p * 3.0f) * 0.6f;
+    float h4 = FastMath::sin2Pi(p * 4.0f) * 0.5f;
+    float h5 = FastMath::sin2Pi(p * 5.0f) * 0.45f;
+    float h7 = FastMath::sin2Pi(p * 7.0f) * 0.35f;
+    float h9 = FastMath::sin2Pi(p * 9.0f) * 0.25f;
+    float h11 = FastMath::sin2Pi(p * 11.0f) * 0.2f;
 
     float complex = saw + h2 + h3 + h4 + h5 + h7 + h9 + h11;
 
     // Aggressive wave folding - multiple passes
-    complex = std::sin(complex * 2.5f);
-    complex = std::tanh(complex * 3.0f);
+    complex = FastMath::sin2Pi(complex * (2.5f / juce::MathConstants<float>::twoPi));
+    complex = FastMath::tanh(complex * 3.0f);
 
     // Add some edge with soft clipping
     if (complex > 0.8f) complex = 0.8f + (complex - 0.8f) * 0.3f;
@@ -142,27 +66,9 @@ float Oscillator::generateChaos() const
     return std::clamp(complex, -1.0f, 1.0f);
 }
 
-float Oscillator::generateMorphedWaveform() const
+float Oscillator::getChaosWrapStep()
 {
-    // Morph through: sine (0) -> triangle (0.33) -> square (0.66) -> chaos (1.0)
-    const float pos = waveformPosition;
-
-    if (pos <= 0.33f)
-    {
-        // Morph from sine to triangle
-        float blend = pos / 0.33f;
-        return generateSine() * (1.0f - blend) + generateTriangle() * blend;
-    }
-    else if (pos <= 0.66f)
-    {
-        // Morph from triangle to square
-        float blend = (pos - 0.33f) / 0.33f;
-        return generateTriangle() * (1.0f - blend) + generateSquare() * blend;
-    }
-    else
-    {
-        // Morph from square to chaos
-        float blend = (pos - 0.66f) / 0.34f;
-        return generateSquare() * (1.0f - blend) + generateChaos() * blend;
-    }
+    // The chaos waveform is fixed, so its wrap discontinuity is computed once
+    static const float step = generateChaos(0.0) - generateChaos(std::nextafter(1.0, 0.0));
+    return step;
 }
@@ -1,46 +1,20 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "MorphWavetable.h"
 
+// The VCO waveforms, which OscillatorBank renders. Each generator takes a phase from 0 to 1.
 class Oscillator
 {
 public:
-    Oscillator();
-
-    void prepare(double sampleRate);
-    void setFrequency(float frequency);
-
-    // Continuous waveform: 0=sine, 0.33=triangle, 0.66=square, 1.0=chaos
-    void setWaveformPosition(float position);
-
-    // Get next sample
-    float process();
-
-    // Process with FM input (frequency modulation)
-    float process(float fmInput, float fmAmount);
-
-    // Process with pitch modulation (for envelope/sequencer pitch mod)
-    float processWithPitchMod(float pitchModSemitones);
-
-    // Hard sync - reset phase when master oscillator completes cycle
-    void sync();
-
-    // Get current phase (for sync detection)
-    double getPhase() const { return phase; }
-    bool hasCompletedCycle() const { return completedCycle; }
-
-private:
-    double sampleRate = 44100.0;
-    float frequency = 100.0f;
-    double phase = 0.0;
-    double phaseIncrement = 0.0;
-    float waveformPosition = 0.0f;  // 0=sine, 0.33=tri, 0.66=square, 1=chaos
-    bool completedCycle = false;
-
-    void updatePhaseIncrement();
-    float generateSine() const;
-    float generateTriangle() const;
-    float generateSquare() const;
-    float generateChaos() const;
-    float generateMorphedWaveform() const;
+    // Table with rows sine, triangle, square, chaos. Built on first use (OscillatorBank's
+    // prepare() calls this so it never happens on the audio thread) and shared by all voices.
+    static const MorphWavetable& getSharedWavetable();
+
+    // Naive waveform generators
+    static float generateSine(double p);
+    static float generateTriangle(double p);
+    static float generateSquare(double p);
+    static float generateChaos(double p);
+    static float getChaosWrapStep();  // height of the chaos sawtooth's step at the wrap
 };
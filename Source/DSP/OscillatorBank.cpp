@@ -0,0 +1,408 @@
+#include "OscillatorBank.h"
+#include "FastMath.h"
+#include "Oscillator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr double CYCLE = 4294967296.0;  // 2^32, one cycle of a phase accumulator
+    constexpr uint32_t HALF_CYCLE = 0x80000000u;
+
+    inline double toCycles(uint32_t phase)
+    {
+        return static_cast<double>(phase) * (1.0 / CYCLE);
+    }
+
+    inline uint64_t toStep(double increment)
+    {
+        // Rounded, so the accumulator doesn't drift flat over long notes
+        return increment > 0.0 ? static_cast<uint64_t>(increment * CYCLE + 0.5) : 0;
+    }
+
+    // Soft clip past ±0.8, then hard clip, as in Oscillator::generateChaos
+    inline float clipChaos(float x)
+    {
+        if (x > 0.8f) x = 0.8f + (x - 0.8f) * 0.3f;
+        if (x < -0.8f) x = -0.8f + (x + 0.8f) * 0.3f;
+        return std::clamp(x, -1.0f, 1.0f);
+    }
+}
+
+void OscillatorBank::prepare(double newSampleRate)
+{
+    const double frequency1 = vco1.baseIncrement * sampleRate;
+    const double frequency2 = vco2.baseIncrement * sampleRate;
+
+    sampleRate = newSampleRate;
+    vco1 = {};
+    vco2 = {};
+    vco1.baseIncrement = frequency1 / sampleRate;
+    vco2.baseIncrement = frequency2 / sampleRate;
+    subPhase = 0;
+    subPendingCorrection = 0.0f;
+
+    Oscillator::getSharedWavetable();
+}
+
+void OscillatorBank::setFrequencies(float vco1Hz, float vco2Hz)
+{
+    vco1.baseIncrement = vco1Hz / sampleRate;
+    vco2.baseIncrement = vco2Hz / sampleRate;
+}
+
+void OscillatorBank::setBandLimited(bool shouldBandLimit)
+{
+    bandLimited = shouldBandLimit;
+    if (!bandLimited)
+    {
+        vco1.pendingCorrection = 0.0f;
+        vco2.pendingCorrection = 0.0f;
+        subPendingCorrection = 0.0f;
+    }
+}
+
+void OscillatorBank::setWavetableEnabled(bool shouldUseWavetable)
+{
+    wavetable = shouldUseWavetable ? &Oscillator::getSharedWavetable() : nullptr;
+}
+
+void OscillatorBank::process(const Controls& controls, int numSamples, int factor, float* output)
+{
+    // Hard sync and the sub select a kernel compiled with or without them
+    static constexpr Kernel kernels[] = {
+        &OscillatorBank::render<false, false>,
+        &OscillatorBank::render<false, true>,
+        &OscillatorBank::render<true, false>,
+        &OscillatorBank::render<true, true>
+    };
+
+    const int index = (controls.hardSync ? 2 : 0) + (controls.subLevel != 0.0f ? 1 : 0);
+    (this->*kernels[index])(controls, numSamples, factor, output);
+}
+
+template <bool hardSync, bool withSub>
+void OscillatorBank::render(const Controls& controls, int numSamples, int factor, float* output)
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const Morph morph1 = getMorph(controls.vco1Wave[i]);
+        const Morph morph2 = getMorph(controls.vco2Wave[i]);
+
+        const double increment2 = vco2.baseIncrement * controls.vco2PitchMult[i];
+        const double unmodulatedIncrement1 = vco1.baseIncrement * controls.vco1PitchMult[i];
+        const uint32_t subStep = static_cast<uint32_t>(std::min(toStep(unmodulatedIncrement1), uint64_t(0xffffffffu)) >> 1);
+
+        // ±24 semitones of FM at full amount, as an octave multiplier per unit of VCO2 output
+        const float fmOctaves = controls.fmAmount[i] * 2.0f;
+        const float level1 = controls.vco1Level[i];
+        const float level2 = controls.vco2Level[i];
+        const float noise = controls.noise[i];
+
+        for (int j = 0; j < factor; ++j)
+        {
+            float wave1, wave2;
+            evaluateWaveforms(morph1, morph2, vco1.lastIncrement, increment2, wave1, wave2);
+
+            // VCO2 first: it drives VCO1's FM and sync
+            const float out2 = advance(vco2, morph2, increment2, wave2, false, 0.0);
+
+            const double increment1 = fmOctaves != 0.0f
+                ? unmodulatedIncrement1 * FastMath::exp2(out2 * fmOctaves)
+                : unmodulatedIncrement1;
+            const bool sync = hardSync && vco2.completedCycle;
+            const float out1 = advance(vco1, morph1, increment1, wave1, sync, vco2.cycleCompletionOffset);
+
+            float mixed = out1 * level1 + out2 * level2 + noise;
+
+            if constexpr (withSub)
+            {
+                mixed += advanceSub(subStep) * controls.subLevel;
+            }
+            else
+            {
+                // Silent sub: keep its phase locked to VCO1 so it comes back in step
+                subPhase += subStep;
+                subPendingCorrection = 0.0f;
+            }
+
+            output[i * factor + j] = mixed;
+        }
+    }
+}
+
+OscillatorBank::Morph OscillatorBank::getMorph(float position)
+{
+    // Morph through: sine (0) -> triangle (0.33) -> square (0.66) -> chaos (1.0).
+    // Table rows sit at the breakpoints, so the row position follows the same crossfade.
+    const float pos = std::clamp(position, 0.0f, 1.0f);
+    Morph morph;
+
+    if (pos <= 0.33f)
+    {
+        const float blend = pos / 0.33f;
+        morph.sine = 1.0f - blend;
+        morph.triangle = blend;
+        morph.row = blend;
+    }
+    else if (pos <= 0.66f)
+    {
+        const float blend = (pos - 0.33f) / 0.33f;
+        morph.triangle = 1.0f - blend;
+        morph.square = blend;
+        morph.row = 1.0f + blend;
+    }
+    else
+    {
+        const float blend = (pos - 0.66f) / 0.34f;
+        morph.square = 1.0f - blend;
+        morph.chaos = blend;
+        morph.row = 2.0f + blend;
+    }
+
+    return morph;
+}
+
+void OscillatorBank::evaluateWaveforms(const Morph& morph1, const Morph& morph2, double increment1, double increment2,
+                                       float& out1, float& out2) const
+{
+    const double phase1 = toCycles(vco1.phase);
+    const double phase2 = toCycles(vco2.phase);
+
+    if (wavetable != nullptr)
+    {
+        out1 = wavetable->lookup(MorphWavetable::getLevelForIncrement(increment1), morph1.row, phase1);
+        out2 = wavetable->lookup(MorphWavetable::getLevelForIncrement(increment2), morph2.row, phase2);
+        return;
+    }
+
+   #if DFAM_FASTMATH_SSE2
+    const float p1 = static_cast<float>(phase1);
+    const float p2 = static_cast<float>(phase2);
+    const bool needsChaos = morph1.chaos > 0.0f || morph2.chaos > 0.0f;
+
+    float sine1 = 0.0f, sine2 = 0.0f;
+    float chaos1 = 0.0f, chaos2 = 0.0f;
+
+    if (needsChaos)
+    {
+        // Lanes {VCO1, VCO1, VCO2, VCO2}: the chaos partials in pairs, with the fundamental
+        // riding along in the (1, 11) pair to give the sine
+        const __m128 phases = _mm_setr_ps(p1, p1, p2, p2);
+        const auto partials = [&phases](float a, float b, float gainA, float gainB)
+        {
+            const __m128 s = FastMath::sin2Pi(_mm_mul_ps(phases, _mm_setr_ps(a, b, a, b)));
+            return _mm_mul_ps(s, _mm_setr_ps(gainA, gainB, gainA, gainB));
+        };
+
+        const __m128 fundamental = FastMath::sin2Pi(_mm_mul_ps(phases, _mm_setr_ps(1.0f, 11.0f, 1.0f, 11.0f)));
+        __m128 sum = _mm_add_ps(partials(2.0f, 3.0f, 0.7f, 0.6f), partials(4.0f, 5.0f, 0.5f, 0.45f));
+        sum = _mm_add_ps(sum, partials(7.0f, 9.0f, 0.35f, 0.25f));
+        sum = _mm_add_ps(sum, _mm_mul_ps(fundamental, _mm_setr_ps(0.0f, 0.2f, 0.0f, 0.2f)));
+
+        // Pairwise sums land in lanes 0 (VCO1) and 2 (VCO2)
+        sum = _mm_add_ps(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(2, 3, 0, 1)));
+        const __m128 saw = _mm_setr_ps(static_cast<float>(1.0 - 2.0 * phase1), 0.0f,
+                                       static_cast<float>(1.0 - 2.0 * phase2), 0.0f);
+        const __m128 complex = _mm_add_ps(saw, sum);
+
+        // Wave folding on both oscillators at once
+        const __m128 folded = FastMath::sin2Pi(_mm_mul_ps(complex, _mm_set1_ps(2.5f / juce::MathConstants<float>::twoPi)));
+        const __m128 shaped = FastMath::tanh(_mm_mul_ps(folded, _mm_set1_ps(3.0f)));
+
+        alignas(16) float fundamentals[4];
+        alignas(16) float chaos[4];
+        _mm_store_ps(fundamentals, fundamental);
+        _mm_store_ps(chaos, shaped);
+        sine1 = fundamentals[0];
+        sine2 = fundamentals[2];
+        chaos1 = clipChaos(chaos[0]);
+        chaos2 = clipChaos(chaos[2]);
+    }
+    else if (morph1.sine > 0.0f || morph2.sine > 0.0f)
+    {
+        alignas(16) float sines[4];
+        _mm_store_ps(sines, FastMath::sin2Pi(_mm_setr_ps(p1, p2, 0.0f, 0.0f)));
+        sine1 = sines[0];
+        sine2 = sines[1];
+    }
+
+    out1 = sine1 * morph1.sine + Oscillator::generateTriangle(phase1) * morph1.triangle
+         + Oscillator::generateSquare(phase1) * morph1.square + chaos1 * morph1.chaos;
+    out2 = sine2 * morph2.sine + Oscillator::generateTriangle(phase2) * morph2.triangle
+         + Oscillator::generateSquare(phase2) * morph2.square + chaos2 * morph2.chaos;
+   #else
+    out1 = evaluateWaveform(morph1, phase1, increment1);
+    out2 = evaluateWaveform(morph2, phase2, increment2);
+   #endif
+}
+
+float OscillatorBank::evaluateWaveform(const Morph& morph, double phase, double increment) const
+{
+    if (wavetable != nullptr)
+        return wavetable->lookup(MorphWavetable::getLevelForIncrement(increment), morph.row, phase);
+
+    float output = 0.0f;
+
+    if (morph.sine > 0.0f)
+        output += Oscillator::generateSine(phase) * morph.sine;
+    if (morph.triangle > 0.0f)
+        output += Oscillator::generateTriangle(phase) * morph.triangle;
+    if (morph.square > 0.0f)
+        output += Oscillator::generateSquare(phase) * morph.square;
+    if (morph.chaos > 0.0f)
+        output += Oscillator::generateChaos(phase) * morph.chaos;
+
+    return output;
+}
+
+float OscillatorBank::advance(Vco& vco, const Morph& morph, double increment, float wave, bool sync, double syncOffset)
+{
+    vco.completedCycle = false;
+    vco.lastIncrement = increment;
+
+    // PolyBLEP needs at most one edge of each kind per sample; anything faster falls back
+    // to the naive waveform
+    if (!bandLimited || increment <= 0.0 || increment >= 0.5)
+    {
+        vco.pendingCorrection = 0.0f;
+
+        if (sync)
+        {
+            vco.phase = 0;
+            wave = evaluateWaveform(morph, 0.0, increment);
+        }
+
+        const uint64_t next = static_cast<uint64_t>(vco.phase) + toStep(increment);
+        vco.phase = static_cast<uint32_t>(next);
+        if (next >= static_cast<uint64_t>(CYCLE))
+        {
+            vco.completedCycle = true;
+            vco.cycleCompletionOffset = increment > 0.0 ? std::min(toCycles(vco.phase) / increment, 1.0) : 0.0;
+        }
+
+        return wave;
+    }
+
+    const double phase = toCycles(vco.phase);
+    float output = wave + vco.pendingCorrection;
+    vco.pendingCorrection = 0.0f;
+
+    if (sync)
+    {
+        syncOffset = std::clamp(syncOffset, 0.0, 1.0);
+
+        // Run up to the reset point, then restart from phase 0 for the rest of the sample
+        const double syncTime = 1.0 - syncOffset;
+        const double syncPhase = phase + syncTime * increment;
+        addEdgeCorrections(vco, phase, syncPhase, 0.0, increment, morph, output);
+
+        double phaseAtReset = syncPhase;
+        if (phaseAtReset >= 1.0)
+        {
+            phaseAtReset -= 1.0;
+            vco.completedCycle = true;
+            vco.cycleCompletionOffset = std::min(syncOffset + phaseAtReset / increment, 1.0);
+        }
+
+        // Step and corner from jumping back to phase 0
+        const float step = evaluateWaveform(morph, 0.0, increment) - evaluateWaveform(morph, phaseAtReset, increment);
+        const float triangleSlope = phaseAtReset < 0.5 ? 0.0f : 8.0f;
+        const float sineSlope = 2.0f * juce::MathConstants<float>::pi
+                              * (1.0f - static_cast<float>(std::cos(2.0 * juce::MathConstants<double>::pi * phaseAtReset)));
+        const float slopeChange = (morph.triangle * triangleSlope + morph.sine * sineSlope) * static_cast<float>(increment);
+        addStep(step, syncOffset, output, vco.pendingCorrection);
+        addCorner(slopeChange, syncOffset, output, vco.pendingCorrection);
+
+        const double newPhase = syncOffset * increment;
+        vco.phase = static_cast<uint32_t>(toStep(newPhase));
+        addEdgeCorrections(vco, 0.0, newPhase, syncTime, increment, morph, output);
+        return output;
+    }
+
+    addEdgeCorrections(vco, phase, phase + increment, 0.0, increment, morph, output);
+
+    const uint64_t next = static_cast<uint64_t>(vco.phase) + toStep(increment);
+    vco.phase = static_cast<uint32_t>(next);
+    if (next >= static_cast<uint64_t>(CYCLE))
+    {
+        vco.completedCycle = true;
+        vco.cycleCompletionOffset = std::min(toCycles(vco.phase) / increment, 1.0);
+    }
+
+    return output;
+}
+
+void OscillatorBank::addEdgeCorrections(Vco& vco, double from, double to, double startTime, double increment,
+                                        const Morph& morph, float& current) const
+{
+    // Wavetable levels are already band-limited; only sync resets need correcting
+    if (wavetable != nullptr)
+        return;
+
+    // Edges at half cycle: square steps down, triangle peaks
+    if (from < 0.5 && to >= 0.5)
+    {
+        const double distance = 1.0 - (startTime + (0.5 - from) / increment);
+        addStep(-2.0f * morph.square, distance, current, vco.pendingCorrection);
+        addCorner(-8.0f * morph.triangle * static_cast<float>(increment), distance, current, vco.pendingCorrection);
+    }
+
+    // Edges at the wrap: square steps up, triangle troughs, chaos sawtooth resets
+    if (from < 1.0 && to >= 1.0)
+    {
+        const double distance = 1.0 - (startTime + (1.0 - from) / increment);
+        addStep(2.0f * morph.square + Oscillator::getChaosWrapStep() * morph.chaos, distance, current, vco.pendingCorrection);
+        addCorner(8.0f * morph.triangle * static_cast<float>(increment), distance, current, vco.pendingCorrection);
+    }
+}
+
+void OscillatorBank::addStep(float height, double distance, float& current, float& pending)
+{
+    // Two-sample PolyBLEP residual. distance is the time from the edge to the next sample
+    const float d = static_cast<float>(std::clamp(distance, 0.0, 1.0));
+    const float rest = 1.0f - d;
+    current += height * 0.5f * d * d;
+    pending -= height * 0.5f * rest * rest;
+}
+
+void OscillatorBank::addCorner(float slopeChange, double distance, float& current, float& pending)
+{
+    // Two-sample PolyBLAMP residual (integrated PolyBLEP), slopeChange in units per sample
+    const float d = static_cast<float>(std::clamp(distance, 0.0, 1.0));
+    const float rest = 1.0f - d;
+    current += slopeChange * d * d * d / 6.0f;
+    pending += slopeChange * rest * rest * rest / 6.0f;
+}
+
+float OscillatorBank::advanceSub(uint32_t step)
+{
+    // The square's edges are corrected whenever the VCOs are band-limited, by PolyBLEP or by
+    // the wavetable
+    const bool corrected = bandLimited || wavetable != nullptr;
+
+    float output = subPhase < HALF_CYCLE ? 1.0f : -1.0f;
+    const uint64_t next = static_cast<uint64_t>(subPhase) + step;
+
+    if (corrected && step > 0 && step < HALF_CYCLE)
+    {
+        output += subPendingCorrection;
+        subPendingCorrection = 0.0f;
+
+        const double increment = toCycles(step);
+        const double from = toCycles(subPhase);
+        const double to = from + increment;
+
+        if (from < 0.5 && to >= 0.5)
+            addStep(-2.0f, 1.0 - (0.5 - from) / increment, output, subPendingCorrection);
+        if (to >= 1.0)
+            addStep(2.0f, 1.0 - (1.0 - from) / increment, output, subPendingCorrection);
+    }
+    else
+    {
+        subPendingCorrection = 0.0f;
+    }
+
+    subPhase = static_cast<uint32_t>(next);
+    return output;
+}
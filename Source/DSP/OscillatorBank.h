@@ -0,0 +1,99 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <cstdint>
+#include "MorphWavetable.h"
+
+// VCO1, VCO2 and the sub oscillator rendered together in one pass.
+//
+// Both VCOs keep 32-bit fixed-point phase accumulators (one cycle = 2^32), so advancing is
+// an integer add and the wrap is the overflow. Each sample the two morphed waveforms are
+// evaluated side by side in SIMD lanes. The advance, FM from VCO2 to VCO1, hard sync and the
+// PolyBLEP/PolyBLAMP corrections then run per oscillator, VCO2 first since it drives VCO1.
+//
+// The sub oscillator is a divide-by-two of VCO1: a square whose accumulator advances by half
+// of VCO1's phase step before FM, so it tracks VCO1's pitch without any pitch math of its own
+// and stays clear of the FM and sync applied to VCO1.
+class OscillatorBank
+{
+public:
+    // Control buffers, one value per host-rate sample (held across oversampled samples)
+    struct Controls
+    {
+        const float* vco1PitchMult = nullptr;  // frequency multipliers, 2^(semitones / 12)
+        const float* vco2PitchMult = nullptr;
+        const float* vco1Wave = nullptr;       // 0=sine, 0.33=triangle, 0.66=square, 1=chaos
+        const float* vco2Wave = nullptr;
+        const float* fmAmount = nullptr;       // VCO2 -> VCO1 FM, 1 = ±24 semitones
+        const float* vco1Level = nullptr;
+        const float* vco2Level = nullptr;
+        const float* noise = nullptr;          // added to the mix as is
+        float subLevel = 0.0f;
+        bool hardSync = false;                 // VCO2 resets VCO1
+    };
+
+    void prepare(double sampleRate);
+    void setFrequencies(float vco1Hz, float vco2Hz);
+
+    // Band-limited mode: PolyBLEP/PolyBLAMP corrections on waveform edges, corners and resets
+    void setBandLimited(bool shouldBandLimit);
+
+    // Read the morph from Oscillator's shared band-limited wavetable
+    void setWavetableEnabled(bool shouldUseWavetable);
+
+    // Mix the oscillators for numSamples control samples into numSamples * factor outputs
+    void process(const Controls& controls, int numSamples, int factor, float* output);
+
+private:
+    struct Morph
+    {
+        float sine = 0.0f;
+        float triangle = 0.0f;
+        float square = 0.0f;
+        float chaos = 0.0f;
+        float row = 0.0f;  // wavetable row position
+    };
+
+    struct Vco
+    {
+        uint32_t phase = 0;
+        double baseIncrement = 0.0;  // cycles per sample at the base frequency
+        double lastIncrement = 0.0;  // picks VCO1's wavetable level before its FM is known
+        float pendingCorrection = 0.0f;  // residual carried into the next sample
+        bool completedCycle = false;
+        double cycleCompletionOffset = 0.0;  // fraction of a sample between wrap and next sample
+    };
+
+    double sampleRate = 44100.0;
+    Vco vco1;
+    Vco vco2;
+
+    // Sub oscillator (square at half of VCO1's step)
+    uint32_t subPhase = 0;
+    float subPendingCorrection = 0.0f;
+
+    bool bandLimited = false;
+    const MorphWavetable* wavetable = nullptr;
+
+    using Kernel = void (OscillatorBank::*)(const Controls&, int, int, float*);
+
+    template <bool hardSync, bool withSub>
+    void render(const Controls& controls, int numSamples, int factor, float* output);
+
+    static Morph getMorph(float position);
+
+    // Waveform of both VCOs at their current phases; increments pick the wavetable levels
+    void evaluateWaveforms(const Morph& morph1, const Morph& morph2, double increment1, double increment2,
+                           float& out1, float& out2) const;
+    float evaluateWaveform(const Morph& morph, double phase, double increment) const;
+
+    // Advance one VCO by increment. wave is its waveform at the current phase; a sync resets
+    // it at syncOffset (fraction of a sample before the next sample).
+    float advance(Vco& vco, const Morph& morph, double increment, float wave, bool sync, double syncOffset);
+    void addEdgeCorrections(Vco& vco, double from, double to, double startTime, double increment,
+                            const Morph& morph, float& current) const;
+    static void addStep(float height, double distance, float& current, float& pending);
+    static void addCorner(float slopeChange, double distance, float& current, float& pending);
+
+    float advanceSub(uint32_t step);
+};
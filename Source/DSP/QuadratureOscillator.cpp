@@ -0,0 +1,113 @@
+#include "QuadratureOscillator.h"
+#include "FastMath.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+   #if DFAM_FASTMATH_SSE2
+    // Each lane takes the one below it, lane 0 takes zero
+    template <int lanes>
+    inline __m128 shiftUp(__m128 x)
+    {
+        return _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4 * lanes));
+    }
+   #endif
+}
+
+void QuadratureOscillator::render(float* output, double increment, int numSamples)
+{
+    for (int start = 0; start < numSamples; start += RENORMALISE_INTERVAL)
+    {
+        const int n = std::min(RENORMALISE_INTERVAL, numSamples - start);
+        float* const out = output + start;
+        const float startPhase = static_cast<float>(phase);
+
+       #if DFAM_FASTMATH_SSE2
+        // Lane k holds sample 4j + k, and each step moves every lane on four samples
+        const float step = static_cast<float>(4.0 * increment);
+        const __m128 rotCos = _mm_set1_ps(FastMath::cos2Pi(step));
+        const __m128 rotSin = _mm_set1_ps(FastMath::sin2Pi(step));
+
+        const __m128 lanePhases = _mm_add_ps(_mm_set1_ps(startPhase),
+                                             _mm_mul_ps(_mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f),
+                                                        _mm_set1_ps(static_cast<float>(increment))));
+        __m128 sine = FastMath::sin2Pi(lanePhases);
+        __m128 cosine = FastMath::sin2Pi(_mm_add_ps(lanePhases, _mm_set1_ps(0.25f)));
+
+        int i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            _mm_storeu_ps(out + i, sine);
+            const __m128 nextSine = _mm_add_ps(_mm_mul_ps(sine, rotCos), _mm_mul_ps(cosine, rotSin));
+            cosine = _mm_sub_ps(_mm_mul_ps(cosine, rotCos), _mm_mul_ps(sine, rotSin));
+            sine = nextSine;
+        }
+
+        // The phasors already hold the last few samples
+        alignas(16) float rest[4];
+        _mm_store_ps(rest, sine);
+        std::copy(rest, rest + (n - i), out + i);
+       #else
+        const float rotCos = FastMath::cos2Pi(static_cast<float>(increment));
+        const float rotSin = FastMath::sin2Pi(static_cast<float>(increment));
+        float sine = FastMath::sin2Pi(startPhase);
+        float cosine = FastMath::cos2Pi(startPhase);
+
+        for (int i = 0; i < n; ++i)
+        {
+            out[i] = sine;
+            const float nextSine = sine * rotCos + cosine * rotSin;
+            cosine = cosine * rotCos - sine * rotSin;
+            sine = nextSine;
+        }
+       #endif
+
+        phase += increment * n;
+        phase -= std::floor(phase);
+    }
+}
+
+void QuadratureOscillator::render(float* output, double increment, const float* freqMult, int numSamples)
+{
+    if (numSamples <= 0)
+        return;
+
+    // A multiplier that holds for the whole block is a steady frequency
+    const float mult = freqMult[0];
+    if (std::all_of(freqMult + 1, freqMult + numSamples, [mult](float m) { return m == mult; }))
+        render(output, increment * mult, numSamples);
+    else
+        renderModulated(output, increment, freqMult, numSamples);
+}
+
+void QuadratureOscillator::renderModulated(float* output, double increment, const float* freqMult, int numSamples)
+{
+    int i = 0;
+
+   #if DFAM_FASTMATH_SSE2
+    // Four samples at a time: each one's phase is the group's start plus the increments
+    // before it. The start moves on in double, so the rounding of the float sums stays
+    // within a group rather than drifting the phase.
+    const __m128 floatIncrement = _mm_set1_ps(static_cast<float>(increment));
+    for (; i + 4 <= numSamples; i += 4)
+    {
+        const __m128 mults = _mm_loadu_ps(freqMult + i);
+        __m128 sums = _mm_add_ps(mults, shiftUp<1>(mults));
+        sums = _mm_add_ps(sums, shiftUp<2>(sums));
+
+        const __m128 offsets = _mm_mul_ps(floatIncrement, _mm_sub_ps(sums, mults));
+        _mm_storeu_ps(output + i, FastMath::sin2Pi(_mm_add_ps(_mm_set1_ps(static_cast<float>(phase)), offsets)));
+
+        phase += increment * (static_cast<double>(freqMult[i]) + freqMult[i + 1] + freqMult[i + 2] + freqMult[i + 3]);
+        phase -= static_cast<double>(static_cast<int>(phase));
+    }
+   #endif
+
+    for (; i < numSamples; ++i)
+    {
+        output[i] = FastMath::sin2Pi(static_cast<float>(phase));
+        phase += increment * freqMult[i];
+    }
+    phase -= std::floor(phase);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Sine oscillator for the ring modulator carrier and the LFO sine, a block at a time.
+//
+// At a steady frequency it rotates a phasor (cos, sin) by the phase increment each sample,
+// a few multiply-adds instead of a sine. The SIMD version runs four phasors one sample
+// apart, each rotated by four increments. The phase itself is still accumulated, and the
+// phasors are rebuilt from it at the start of every block and every RENORMALISE_INTERVAL
+// samples, so rounding in the rotation never builds up in amplitude or phase.
+//
+// A frequency that changes per sample (frequency modulation) can't reuse one rotation, so
+// the phase is accumulated sample by sample and its sine evaluated directly.
+class QuadratureOscillator
+{
+public:
+    static constexpr int RENORMALISE_INTERVAL = 256;
+
+    void reset(double newPhase = 0.0) { phase = newPhase; }
+    double getPhase() const { return phase; }  // cycles, 0 to 1
+
+    // sin(2 pi phase) per sample, the phase advancing by increment (cycles per sample)
+    void render(float* output, double increment, int numSamples);
+
+    // As above with the increment scaled per sample by freqMult
+    void render(float* output, double increment, const float* freqMult, int numSamples);
+
+private:
+    double phase = 0.0;
+
+    void renderModulated(float* output, double increment, const float* freqMult, int numSamples);
+};
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+#include "FastMath.h"
+#include "SimdDispatch.h"
+
+// Counter-based random numbers: value n of a stream is a hash of n and the stream's key,
+// with no hidden generator state. A stream is fully determined by (seed, streamId) and its
+// counter, so renders are reproducible from a seed, separate streams never interfere, and
+// a block of values can be computed in SIMD lanes independently of one another.
+//
+// The hash is a Weyl sequence (counter * golden ratio + key) through Chris Wellons'
+// lowbias32 mixer. Each stream repeats after 2^32 values (27 hours at 44.1 kHz).
+class RandomStream
+{
+public:
+    // Derive the stream key and restart the counter
+    void setSeed(uint32_t seed, uint32_t streamId)
+    {
+        key = hash(seed ^ hash(streamId + 0x9e3779b9u));
+        counter = 0;
+    }
+
+    void reset() { counter = 0; }
+
+    uint32_t nextUInt()
+    {
+        return hash(counter++ * WEYL + key);
+    }
+
+    // Uniform in [-1, 1), 24-bit resolution
+    float nextBipolar()
+    {
+        return toBipolar(nextUInt());
+    }
+
+    // The next numSamples values of nextBipolar()
+    void fillBipolar(float* output, int numSamples)
+    {
+        SimdDispatch::getKernels().fillBipolar(key, counter, output, numSamples);
+        counter += static_cast<uint32_t>(numSamples);
+    }
+
+    // fillBipolar() variants, values counter, counter + 1, ... of the stream with key
+    static void fillBipolarScalar(uint32_t key, uint32_t counter, float* output, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = toBipolar(hash(counter++ * WEYL + key));
+    }
+
+   #if DFAM_FASTMATH_AVX2
+    DFAM_TARGET_AVX2 static void fillBipolarAvx2(uint32_t key, uint32_t counter, float* output, int numSamples)
+    {
+        const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i weyl = _mm256_set1_epi32(static_cast<int>(WEYL));
+        const __m256i keys = _mm256_set1_epi32(static_cast<int>(key));
+        int i = 0;
+        for (; i + 8 <= numSamples; i += 8)
+        {
+            const __m256i n = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(counter)), lane);
+            __m256i x = _mm256_add_epi32(_mm256_mullo_epi32(n, weyl), keys);
+            x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+            x = _mm256_mullo_epi32(x, _mm256_set1_epi32(static_cast<int>(MIX1)));
+            x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 15));
+            x = _mm256_mullo_epi32(x, _mm256_set1_epi32(static_cast<int>(MIX2)));
+            x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+
+            // Top 24 bits as a signed fraction: (x >> 8) / 2^23 - 1
+            const __m256 f = _mm256_cvtepi32_ps(_mm256_srli_epi32(x, 8));
+            _mm256_storeu_ps(output + i, _mm256_sub_ps(_mm256_mul_ps(f, _mm256_set1_ps(SCALE)), _mm256_set1_ps(1.0f)));
+            counter += 8;
+        }
+
+        fillBipolarScalar(key, counter, output + i, numSamples - i);
+    }
+   #endif
+
+   #if DFAM_FASTMATH_AVX512
+    #if defined(__GNUC__) && !defined(__clang__)
+     #pragma GCC diagnostic push
+     #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"  // see FastMath's AVX-512 section
+    #endif
+    DFAM_TARGET_AVX512 static void fillBipolarAvx512(uint32_t key, uint32_t counter, float* output, int numSamples)
+    {
+        const __m512i lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        const __m512i weyl = _mm512_set1_epi32(static_cast<int>(WEYL));
+        const __m512i keys = _mm512_set1_epi32(static_cast<int>(key));
+        int i = 0;
+        for (; i + 16 <= numSamples; i += 16)
+        {
+            const __m512i n = _mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(counter)), lane);
+            __m512i x = _mm512_add_epi32(_mm512_mullo_epi32(n, weyl), keys);
+            x = _mm512_xor_si512(x, _mm512_srli_epi32(x, 16));
+            x = _mm512_mullo_epi32(x, _mm512_set1_epi32(static_cast<int>(MIX1)));
+            x = _mm512_xor_si512(x, _mm512_srli_epi32(x, 15));
+            x = _mm512_mullo_epi32(x, _mm512_set1_epi32(static_cast<int>(MIX2)));
+            x = _mm512_xor_si512(x, _mm512_srli_epi32(x, 16));
+
+            const __m512 f = _mm512_cvtepi32_ps(_mm512_srli_epi32(x, 8));
+            _mm512_storeu_ps(output + i, _mm512_sub_ps(_mm512_mul_ps(f, _mm512_set1_ps(SCALE)), _mm512_set1_ps(1.0f)));
+            counter += 16;
+        }
+
+        fillBipolarScalar(key, counter, output + i, numSamples - i);
+    }
+    #if defined(__GNUC__) && !defined(__clang__)
+     #pragma GCC diagnostic pop
+    #endif
+   #endif
+
+private:
+    static constexpr uint32_t WEYL = 0x9e3779b9u;
+    static constexpr uint32_t MIX1 = 0x7feb352du;
+    static constexpr uint32_t MIX2 = 0x846ca68bu;
+    static constexpr float SCALE = 1.0f / 8388608.0f;  // 2^-23
+
+    uint32_t key = 0;
+    uint32_t counter = 0;
+
+    static uint32_t hash(uint32_t x)
+    {
+        x ^= x >> 16;
+        x *= MIX1;
+        x ^= x >> 15;
+        x *= MIX2;
+        x ^= x >> 16;
+        return x;
+    }
+
+    static float toBipolar(uint32_t x)
+    {
+        return static_cast<float>(x >> 8) * SCALE - 1.0f;
+    }
+};
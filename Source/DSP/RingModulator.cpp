@@ -0,0 +1,22 @@
+#include "RingModulator.h"
+#include <algorithm>
+
+void RingModulator::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    reset();
+}
+
+void RingModulator::process(float* samples, const float* freqMult, int numSamples)
+{
+    for (int start = 0; start < numSamples; start += CHUNK_SIZE)
+    {
+        const int n = std::min(CHUNK_SIZE, numSamples - start);
+
+        // Gain per sample: (1 - mix) + mix * carrier
+        carrier.render(carrierBuffer.data(), phaseIncrement, freqMult + start, n);
+        juce::FloatVectorOperations::multiply(carrierBuffer.data(), mix, n);
+        juce::FloatVectorOperations::add(carrierBuffer.data(), 1.0f - mix, n);
+        juce::FloatVectorOperations::multiply(samples + start, carrierBuffer.data(), n);
+    }
+}
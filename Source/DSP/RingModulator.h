@@ -0,0 +1,30 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include "QuadratureOscillator.h"
+
+// Ring modulator: the signal times a sine, blended with the dry signal by the mix.
+// The sine's frequency is scaled per sample by the sequencer step and mod matrix.
+class RingModulator
+{
+public:
+    void prepare(double sampleRate);
+    void reset() { carrier.reset(); }
+
+    void setFrequency(float hz) { phaseIncrement = hz / sampleRate; }
+    void setMix(float newMix) { mix = newMix; }
+
+    // In place; freqMult holds the per-sample frequency multipliers
+    void process(float* samples, const float* freqMult, int numSamples);
+
+private:
+    static constexpr int CHUNK_SIZE = 64;
+
+    double sampleRate = 44100.0;
+    double phaseIncrement = 0.0;
+    float mix = 0.0f;
+
+    QuadratureOscillator carrier;
+    std::array<float, CHUNK_SIZE> carrierBuffer = {};
+};
@@ -0,0 +1,29 @@
+#include "ScratchArena.h"
+#include <cstdint>
+
+void ScratchArena::allocate(size_t numFloats)
+{
+    capacity = getPaddedSize(numFloats);
+    used = 0;
+
+    // Over-allocate by one cache line so the start can be aligned
+    storage.reset(new float[capacity + FLOATS_PER_LINE]());
+
+    const auto address = reinterpret_cast<std::uintptr_t>(storage.get());
+    const auto aligned = (address + ALIGNMENT - 1) & ~static_cast<std::uintptr_t>(ALIGNMENT - 1);
+    base = reinterpret_cast<float*>(aligned);
+}
+
+float* ScratchArena::take(size_t numFloats)
+{
+    const size_t padded = getPaddedSize(numFloats);
+
+    // The arena was sized too small for the buffers carved from it
+    jassert(used + padded <= capacity);
+    if (used + padded > capacity)
+        return nullptr;
+
+    float* buffer = base + used;
+    used += padded;
+    return buffer;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <cstddef>
+#include <memory>
+
+// One contiguous, zeroed allocation carved into cache-line-aligned float buffers.
+//
+// Sized and carved on the message thread (prepareToPlay); the audio thread only uses the
+// pointers handed out, so processing never touches the allocator. Every buffer starts on
+// its own cache line, so adjacent buffers never share one.
+class ScratchArena
+{
+public:
+    static constexpr size_t ALIGNMENT = 64;  // bytes
+    static constexpr size_t FLOATS_PER_LINE = ALIGNMENT / sizeof(float);
+
+    // Space a buffer of numFloats takes in the arena, padded to whole cache lines
+    static constexpr size_t getPaddedSize(size_t numFloats)
+    {
+        return (numFloats + FLOATS_PER_LINE - 1) / FLOATS_PER_LINE * FLOATS_PER_LINE;
+    }
+
+    // Replace the storage with numFloats zeroed floats and start carving from the beginning.
+    // Pointers from earlier take() calls become invalid.
+    void allocate(size_t numFloats);
+
+    // Next numFloats of the arena (zeroed at allocation). The caller reserves the padded
+    // size of every buffer it takes when calling allocate().
+    float* take(size_t numFloats);
+
+    size_t getCapacity() const { return capacity; }
+
+private:
+    std::unique_ptr<float[]> storage;
+    float* base = nullptr;  // storage rounded up to ALIGNMENT
+    size_t capacity = 0;
+    size_t used = 0;
+};
@@ -0,0 +1,92 @@
+#include "SimdDispatch.h"
+#include "FastMath.h"
+#include "RandomStream.h"
+
+#if defined(_MSC_VER) && !defined(__clang__) && DFAM_FASTMATH_SSE2
+ #include <intrin.h>
+#endif
+
+namespace
+{
+    SimdDispatch::Kernels makeKernels(SimdDispatch::Variant variant)
+    {
+        using SimdDispatch::Variant;
+
+        switch (variant)
+        {
+           #if DFAM_FASTMATH_AVX512
+            case Variant::Avx512:
+                return { variant, FastMath::exp2BlockAvx512, RandomStream::fillBipolarAvx512 };
+           #endif
+           #if DFAM_FASTMATH_AVX2
+            case Variant::Avx2:
+                return { variant, FastMath::exp2BlockAvx2, RandomStream::fillBipolarAvx2 };
+           #endif
+           #if DFAM_FASTMATH_SSE2
+            case Variant::Sse2:
+                // The counter hash needs 32-bit multiplies, which SSE2 lacks
+                return { variant, FastMath::exp2BlockSse2, RandomStream::fillBipolarScalar };
+           #endif
+            default:
+                return { Variant::Scalar, FastMath::exp2BlockScalar, RandomStream::fillBipolarScalar };
+        }
+    }
+}
+
+namespace SimdDispatch
+{
+    const Kernels& getKernels()
+    {
+        static const Kernels kernels = makeKernels(detectVariant());
+        return kernels;
+    }
+
+    Variant detectVariant()
+    {
+       #if DFAM_FASTMATH_SSE2
+        #if defined(_MSC_VER) && !defined(__clang__)
+        // CPUID leaf 7 for the feature bits, XCR0 for the OS saving the wider registers
+        int info[4] = {};
+        __cpuid(info, 0);
+        const int maxLeaf = info[0];
+
+        __cpuid(info, 1);
+        const bool osSavesAvx = (info[2] & (1 << 27)) != 0;  // OSXSAVE
+        const unsigned long long xcr0 = osSavesAvx ? _xgetbv(0) : 0;
+
+        if (maxLeaf >= 7 && (xcr0 & 0x6) == 0x6)
+        {
+            __cpuidex(info, 7, 0);
+            const bool avx2 = (info[1] & (1 << 5)) != 0;
+            const bool avx512 = (info[1] & (1 << 16)) != 0 && (xcr0 & 0xe6) == 0xe6;
+
+            if (avx512)
+                return Variant::Avx512;
+            if (avx2)
+                return Variant::Avx2;
+        }
+        #else
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            return Variant::Avx512;
+        if (__builtin_cpu_supports("avx2"))
+            return Variant::Avx2;
+        #endif
+
+        return Variant::Sse2;
+       #else
+        return Variant::Scalar;
+       #endif
+    }
+
+    const char* getVariantName(Variant variant)
+    {
+        switch (variant)
+        {
+            case Variant::Sse2:   return "SSE2";
+            case Variant::Avx2:   return "AVX2";
+            case Variant::Avx512: return "AVX-512";
+            default:              return "Scalar";
+        }
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+// Runtime choice of the SIMD kernels.
+//
+// The plugin is built for the baseline target (SSE2 on x86-64), so anything wider can't be
+// used unconditionally. The hot block kernels are compiled once per instruction set instead,
+// and the first call to getKernels() reads CPUID and picks the widest set this CPU (and OS)
+// supports. The processor makes that call at construction, off the audio thread.
+//
+// Every variant computes the same operations in the same order, so renders don't depend on
+// the machine they ran on.
+namespace SimdDispatch
+{
+    enum class Variant { Scalar, Sse2, Avx2, Avx512 };
+
+    struct Kernels
+    {
+        Variant variant;
+        void (*exp2Block)(const float* input, float* output, int numSamples);
+
+        // RandomStream::fillBipolar: values counter, counter + 1, ... of the stream with key
+        void (*fillBipolar)(uint32_t key, uint32_t counter, float* output, int numSamples);
+    };
+
+    const Kernels& getKernels();
+
+    // Widest variant the CPU supports (what getKernels() uses)
+    Variant detectVariant();
+
+    // For diagnostics, e.g. "AVX2"
+    const char* getVariantName(Variant variant);
+}
@@ -0,0 +1,122 @@
+#include "StereoPanner.h"
+#include "FastMath.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace
+{
+    // Equal-power gains at evenly spaced pans, read with linear interpolation (within 5e-6
+    // of the exact law)
+    constexpr int PAN_TABLE_SIZE = 256;
+
+    struct PanTable
+    {
+        std::array<float, PAN_TABLE_SIZE + 1> left;
+        std::array<float, PAN_TABLE_SIZE + 1> right;
+
+        PanTable()
+        {
+            // Angle (pan + 1) * pi / 4: left is its cosine, right its sine
+            for (int i = 0; i <= PAN_TABLE_SIZE; ++i)
+            {
+                const double angle = juce::MathConstants<double>::halfPi * i / PAN_TABLE_SIZE;
+                left[static_cast<size_t>(i)] = static_cast<float>(std::cos(angle));
+                right[static_cast<size_t>(i)] = static_cast<float>(std::sin(angle));
+            }
+        }
+    };
+
+    const PanTable& getPanTable()
+    {
+        static const PanTable table;
+        return table;
+    }
+
+    void lookUpGains(float pan, float& left, float& right)
+    {
+        const auto& table = getPanTable();
+        const float position = std::clamp((pan + 1.0f) * 0.5f, 0.0f, 1.0f) * static_cast<float>(PAN_TABLE_SIZE);
+        const int index = std::min(static_cast<int>(position), PAN_TABLE_SIZE - 1);
+        const float frac = position - static_cast<float>(index);
+        const auto i = static_cast<size_t>(index);
+        left = table.left[i] + (table.left[i + 1] - table.left[i]) * frac;
+        right = table.right[i] + (table.right[i + 1] - table.right[i]) * frac;
+    }
+}
+
+void StereoPanner::prepare(double sampleRate)
+{
+    rampLength = std::max(1, static_cast<int>(sampleRate * RAMP_SECONDS));
+    getPanTable();
+    reset();
+}
+
+void StereoPanner::process(const float* input, const float* pan, float* left, float* right, int numSamples)
+{
+    int i = 0;
+    while (i < numSamples)
+    {
+        if (samplesUntilUpdate == 0)
+        {
+            float targetLeft, targetRight;
+            lookUpGains(pan[i], targetLeft, targetRight);
+            if (!started)
+            {
+                gainLeft = targetLeft;
+                gainRight = targetRight;
+                started = true;
+            }
+
+            const float invLength = 1.0f / static_cast<float>(rampLength);
+            stepLeft = (targetLeft - gainLeft) * invLength;
+            stepRight = (targetRight - gainRight) * invLength;
+            samplesUntilUpdate = rampLength;
+        }
+
+        const int runLength = std::min(samplesUntilUpdate, numSamples - i);
+        if (right != nullptr)
+            ramp<true>(input + i, left + i, right + i, runLength);
+        else
+            ramp<false>(input + i, left + i, nullptr, runLength);
+
+        i += runLength;
+        samplesUntilUpdate -= runLength;
+    }
+}
+
+template <bool stereo>
+void StereoPanner::ramp(const float* input, float* left, float* right, int numSamples)
+{
+    int i = 0;
+
+   #if DFAM_FASTMATH_SSE2
+    // Four samples at a time, written straight to the output channels
+    const __m128 ramp = _mm_setr_ps(1.0f, 2.0f, 3.0f, 4.0f);
+    __m128 gainsLeft = _mm_add_ps(_mm_set1_ps(gainLeft), _mm_mul_ps(ramp, _mm_set1_ps(stepLeft)));
+    __m128 gainsRight = _mm_add_ps(_mm_set1_ps(gainRight), _mm_mul_ps(ramp, _mm_set1_ps(stepRight)));
+    const __m128 stepLeft4 = _mm_set1_ps(4.0f * stepLeft);
+    const __m128 stepRight4 = _mm_set1_ps(4.0f * stepRight);
+
+    for (; i + 4 <= numSamples; i += 4)
+    {
+        const __m128 x = _mm_loadu_ps(input + i);
+        _mm_storeu_ps(left + i, _mm_mul_ps(x, gainsLeft));
+        if constexpr (stereo)
+            _mm_storeu_ps(right + i, _mm_mul_ps(x, gainsRight));
+        gainsLeft = _mm_add_ps(gainsLeft, stepLeft4);
+        gainsRight = _mm_add_ps(gainsRight, stepRight4);
+    }
+   #endif
+
+    for (; i < numSamples; ++i)
+    {
+        const float t = static_cast<float>(i + 1);
+        left[i] = input[i] * (gainLeft + stepLeft * t);
+        if constexpr (stereo)
+            right[i] = input[i] * (gainRight + stepRight * t);
+    }
+
+    gainLeft += stepLeft * static_cast<float>(numSamples);
+    gainRight += stepRight * static_cast<float>(numSamples);
+}
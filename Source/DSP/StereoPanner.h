@@ -0,0 +1,41 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Equal-power panner: the mono voice into the host's output channels, a sub-block at a time.
+//
+// Rather than a cosine and a sine per sample, the pan is looked up in a table of gain pairs
+// once per RAMP_SECONDS, and the gains ramp linearly to it over the following RAMP_SECONDS.
+// The gains never jump, so pan steps from the sequencer and stepped modulation don't click.
+// The ramps run on their own grid, carried across calls, so the output doesn't depend on
+// how the blocks are split.
+class StereoPanner
+{
+public:
+    static constexpr double RAMP_SECONDS = 0.001;
+
+    void prepare(double sampleRate);
+
+    // The next block starts at its own gains instead of ramping from the last ones
+    void reset()
+    {
+        started = false;
+        samplesUntilUpdate = 0;
+    }
+
+    // pan per sample, -1 (left) to 1 (right). right is null for mono output, which takes the
+    // left gain.
+    void process(const float* input, const float* pan, float* left, float* right, int numSamples);
+
+private:
+    int rampLength = 1;
+    int samplesUntilUpdate = 0;
+    bool started = false;
+    float gainLeft = 0.0f;
+    float gainRight = 0.0f;
+    float stepLeft = 0.0f;
+    float stepRight = 0.0f;
+
+    template <bool stereo>
+    void ramp(const float* input, float* left, float* right, int numSamples);
+};
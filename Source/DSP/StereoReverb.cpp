@@ -0,0 +1,666 @@
+#include "StereoReverb.h"
+#include "FastMath.h"
+#include "ScratchArena.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr double REFERENCE_RATE = 44100.0;  // the lengths below are in samples at this rate
+    constexpr double PRE_DELAY_SECONDS = 0.03;  // gives depth without being noticeable
+
+    // Line lengths, spread over 23-43 ms and mutually prime so their echoes don't line up
+    constexpr std::array<int, StereoReverb::NUM_LINES> LINE_LENGTHS = { 1031, 1153, 1283, 1399, 1511, 1637, 1753, 1889 };
+
+    // Schroeder allpasses that smear the input before it reaches the network
+    constexpr std::array<int, StereoReverb::NUM_DIFFUSERS> DIFFUSER_LENGTHS = { 142, 107, 379, 277 };
+    constexpr float DIFFUSER_GAIN = 0.7f;
+
+    constexpr double MOD_DEPTH_SECONDS = 0.0003;
+    constexpr std::array<float, StereoReverb::NUM_LINES> MOD_RATES_HZ = { 0.31f, 0.43f, 0.37f, 0.53f, 0.47f, 0.61f, 0.41f, 0.57f };
+
+    // Output taps: orthogonal sign patterns, so the two channels are decorrelated. The input
+    // pattern is none of the Hadamard rows, so it spreads over the network from the first pass.
+    constexpr std::array<float, StereoReverb::NUM_LINES> LEFT_SIGNS = { 1, 1, -1, -1, 1, 1, -1, -1 };
+    constexpr std::array<float, StereoReverb::NUM_LINES> RIGHT_SIGNS = { 1, -1, 1, -1, -1, 1, -1, 1 };
+    constexpr std::array<float, StereoReverb::NUM_LINES> INPUT_SIGNS = { 1, 1, -1, 1, -1, -1, 1, -1 };
+
+    const float LINE_NORM = 1.0f / std::sqrt(static_cast<float>(StereoReverb::NUM_LINES));
+    constexpr float HOUSEHOLDER_SCALE = 2.0f / StereoReverb::NUM_LINES;
+
+    int scaleLength(int length, double sampleRate)
+    {
+        return std::max(1, static_cast<int>(std::lround(length * sampleRate / REFERENCE_RATE)));
+    }
+
+    int getFrameCount(double sampleRate)
+    {
+        const int longest = scaleLength(LINE_LENGTHS.back(), sampleRate);
+        const int modulation = static_cast<int>(std::ceil(sampleRate * MOD_DEPTH_SECONDS));
+        return juce::nextPowerOfTwo(longest + modulation + 2);
+    }
+
+    int getPreDelaySize(double sampleRate)
+    {
+        return DelayLine<float>::getBufferSize(static_cast<int>(sampleRate * PRE_DELAY_SECONDS));
+    }
+
+    int getDiffuserSize(int diffuser, double sampleRate)
+    {
+        return DelayLine<float>::getBufferSize(scaleLength(DIFFUSER_LENGTHS[static_cast<size_t>(diffuser)], sampleRate));
+    }
+
+    int padded(int numFloats)
+    {
+        return static_cast<int>(ScratchArena::getPaddedSize(static_cast<size_t>(numFloats)));
+    }
+
+    // Largest decimation whose network band still has the wet lowpass cutoff in its lower
+    // half. Above that the one-pole has only taken a few dB off, so dropping the rest would
+    // be heard.
+    int getLargestDecimation(double cutoff, double hostSampleRate)
+    {
+        int factor = 1;
+        while (factor < StereoReverb::MAX_DECIMATION && cutoff <= 0.25 * hostSampleRate / (factor * 2))
+            factor *= 2;
+        return factor;
+    }
+
+    // A larger factor is only taken once the cutoff is this far inside its band
+    constexpr double DECIMATION_HYSTERESIS = 1.25;
+
+    // 0.8 to 2.4 s to fall 60 dB
+    double getT60(float decay)
+    {
+        return 0.8 + 1.6 * decay;
+    }
+
+    // Eight lanes as one value, for each instruction set. Every version adds, multiplies and
+    // sums in the same order, so all of them produce the same output.
+    //
+    // sum() adds (0+4) + (2+6) and (1+5) + (3+7), then the two; hadamard() runs the
+    // butterflies over neighbours, then pairs, then halves.
+    struct ScalarLanes
+    {
+        std::array<float, 8> v;
+
+        static ScalarLanes load(const float* p) { ScalarLanes r; std::copy(p, p + 8, r.v.begin()); return r; }
+        static void store(float* p, const ScalarLanes& a) { std::copy(a.v.begin(), a.v.end(), p); }
+        static ScalarLanes set1(float x) { ScalarLanes r; r.v.fill(x); return r; }
+        static ScalarLanes gather(const float* base, const int* offsets) { ScalarLanes r; for (size_t k = 0; k < 8; ++k) r.v[k] = base[offsets[k]]; return r; }
+
+        static ScalarLanes add(const ScalarLanes& a, const ScalarLanes& b) { ScalarLanes r; for (size_t k = 0; k < 8; ++k) r.v[k] = a.v[k] + b.v[k]; return r; }
+        static ScalarLanes sub(const ScalarLanes& a, const ScalarLanes& b) { ScalarLanes r; for (size_t k = 0; k < 8; ++k) r.v[k] = a.v[k] - b.v[k]; return r; }
+        static ScalarLanes mul(const ScalarLanes& a, const ScalarLanes& b) { ScalarLanes r; for (size_t k = 0; k < 8; ++k) r.v[k] = a.v[k] * b.v[k]; return r; }
+        static ScalarLanes fraction(const ScalarLanes& a) { ScalarLanes r; for (size_t k = 0; k < 8; ++k) r.v[k] = a.v[k] - static_cast<float>(static_cast<int>(a.v[k])); return r; }
+
+        static float sum(const ScalarLanes& a)
+        {
+            const auto& p = a.v;
+            return ((p[0] + p[4]) + (p[2] + p[6])) + ((p[1] + p[5]) + (p[3] + p[7]));
+        }
+
+        static ScalarLanes hadamard(ScalarLanes a)
+        {
+            for (size_t distance = 1; distance < 8; distance <<= 1)
+            {
+                for (size_t k = 0; k < 8; ++k)
+                {
+                    if ((k & distance) == 0)
+                    {
+                        const float x = a.v[k];
+                        const float y = a.v[k + distance];
+                        a.v[k] = x + y;
+                        a.v[k + distance] = x - y;
+                    }
+                }
+            }
+            return a;
+        }
+    };
+
+   #if DFAM_FASTMATH_SSE2
+    struct Sse2Lanes
+    {
+        __m128 lo, hi;
+
+        static Sse2Lanes load(const float* p) { return { _mm_loadu_ps(p), _mm_loadu_ps(p + 4) }; }
+        static void store(float* p, const Sse2Lanes& a) { _mm_storeu_ps(p, a.lo); _mm_storeu_ps(p + 4, a.hi); }
+        static Sse2Lanes set1(float x) { return { _mm_set1_ps(x), _mm_set1_ps(x) }; }
+
+        static Sse2Lanes gather(const float* base, const int* offsets)
+        {
+            return { _mm_setr_ps(base[offsets[0]], base[offsets[1]], base[offsets[2]], base[offsets[3]]),
+                     _mm_setr_ps(base[offsets[4]], base[offsets[5]], base[offsets[6]], base[offsets[7]]) };
+        }
+
+        static Sse2Lanes add(const Sse2Lanes& a, const Sse2Lanes& b) { return { _mm_add_ps(a.lo, b.lo), _mm_add_ps(a.hi, b.hi) }; }
+        static Sse2Lanes sub(const Sse2Lanes& a, const Sse2Lanes& b) { return { _mm_sub_ps(a.lo, b.lo), _mm_sub_ps(a.hi, b.hi) }; }
+        static Sse2Lanes mul(const Sse2Lanes& a, const Sse2Lanes& b) { return { _mm_mul_ps(a.lo, b.lo), _mm_mul_ps(a.hi, b.hi) }; }
+
+        static Sse2Lanes fraction(const Sse2Lanes& a)
+        {
+            return { _mm_sub_ps(a.lo, _mm_cvtepi32_ps(_mm_cvttps_epi32(a.lo))),
+                     _mm_sub_ps(a.hi, _mm_cvtepi32_ps(_mm_cvttps_epi32(a.hi))) };
+        }
+
+        static float sum(const Sse2Lanes& a)
+        {
+            const __m128 q = _mm_add_ps(a.lo, a.hi);
+            const __m128 r = _mm_add_ps(q, _mm_movehl_ps(q, q));
+            return _mm_cvtss_f32(_mm_add_ss(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 1, 1, 1))));
+        }
+
+        // Butterfly within each half: x + swapped, with the upper element of each pair negated
+        static __m128 butterfly1(__m128 x)
+        {
+            const __m128 sign = _mm_castsi128_ps(_mm_setr_epi32(0, static_cast<int>(0x80000000), 0, static_cast<int>(0x80000000)));
+            return _mm_add_ps(_mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1)), _mm_xor_ps(x, sign));
+        }
+
+        static __m128 butterfly2(__m128 x)
+        {
+            const __m128 sign = _mm_castsi128_ps(_mm_setr_epi32(0, 0, static_cast<int>(0x80000000), static_cast<int>(0x80000000)));
+            return _mm_add_ps(_mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 0, 3, 2)), _mm_xor_ps(x, sign));
+        }
+
+        static Sse2Lanes hadamard(const Sse2Lanes& a)
+        {
+            const __m128 lo = butterfly2(butterfly1(a.lo));
+            const __m128 hi = butterfly2(butterfly1(a.hi));
+            return { _mm_add_ps(lo, hi), _mm_sub_ps(lo, hi) };
+        }
+    };
+   #endif
+
+   #if DFAM_FASTMATH_AVX2
+    struct Avx2Lanes
+    {
+        __m256 v;
+
+        DFAM_TARGET_AVX2 static Avx2Lanes load(const float* p) { return { _mm256_loadu_ps(p) }; }
+        DFAM_TARGET_AVX2 static void store(float* p, const Avx2Lanes& a) { _mm256_storeu_ps(p, a.v); }
+        DFAM_TARGET_AVX2 static Avx2Lanes set1(float x) { return { _mm256_set1_ps(x) }; }
+
+        DFAM_TARGET_AVX2 static Avx2Lanes gather(const float* base, const int* offsets)
+        {
+            return { _mm256_setr_ps(base[offsets[0]], base[offsets[1]], base[offsets[2]], base[offsets[3]],
+                                    base[offsets[4]], base[offsets[5]], base[offsets[6]], base[offsets[7]]) };
+        }
+
+        DFAM_TARGET_AVX2 static Avx2Lanes add(const Avx2Lanes& a, const Avx2Lanes& b) { return { _mm256_add_ps(a.v, b.v) }; }
+        DFAM_TARGET_AVX2 static Avx2Lanes sub(const Avx2Lanes& a, const Avx2Lanes& b) { return { _mm256_sub_ps(a.v, b.v) }; }
+        DFAM_TARGET_AVX2 static Avx2Lanes mul(const Avx2Lanes& a, const Avx2Lanes& b) { return { _mm256_mul_ps(a.v, b.v) }; }
+        DFAM_TARGET_AVX2 static Avx2Lanes fraction(const Avx2Lanes& a) { return { _mm256_sub_ps(a.v, _mm256_cvtepi32_ps(_mm256_cvttps_epi32(a.v))) }; }
+
+        DFAM_TARGET_AVX2 static float sum(const Avx2Lanes& a)
+        {
+            const __m128 q = _mm_add_ps(_mm256_castps256_ps128(a.v), _mm256_extractf128_ps(a.v, 1));
+            const __m128 r = _mm_add_ps(q, _mm_movehl_ps(q, q));
+            return _mm_cvtss_f32(_mm_add_ss(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 1, 1, 1))));
+        }
+
+        DFAM_TARGET_AVX2 static Avx2Lanes hadamard(const Avx2Lanes& a)
+        {
+            const __m256 sign1 = _mm256_castsi256_ps(_mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull)));
+            const __m256 sign2 = _mm256_castsi256_ps(_mm256_setr_epi32(0, 0, static_cast<int>(0x80000000), static_cast<int>(0x80000000),
+                                                                       0, 0, static_cast<int>(0x80000000), static_cast<int>(0x80000000)));
+            const __m256 sign4 = _mm256_castsi256_ps(_mm256_setr_epi32(0, 0, 0, 0, static_cast<int>(0x80000000), static_cast<int>(0x80000000),
+                                                                       static_cast<int>(0x80000000), static_cast<int>(0x80000000)));
+            __m256 x = a.v;
+            x = _mm256_add_ps(_mm256_permute_ps(x, _MM_SHUFFLE(2, 3, 0, 1)), _mm256_xor_ps(x, sign1));
+            x = _mm256_add_ps(_mm256_permute_ps(x, _MM_SHUFFLE(1, 0, 3, 2)), _mm256_xor_ps(x, sign2));
+            x = _mm256_add_ps(_mm256_permute2f128_ps(x, x, 0x01), _mm256_xor_ps(x, sign4));
+            return { x };
+        }
+    };
+   #endif
+}
+
+// wetOnly loops (for the decimated network) take the mono send in left and return the
+// lowpassed wet signal in left and right, leaving the mix to the caller
+struct StereoReverb::Kernels
+{
+    template <typename Lanes, Quality tier, bool wetOnly>
+    JUCE_FORCEINLINE static void process(StereoReverb& r, float* left, float* right, int numSamples)
+    {
+        constexpr int numDiffusers = tier == Quality::Eco ? 0 : tier == Quality::Standard ? 2 : 4;
+
+        const Lanes damp = Lanes::load(r.dampCoeff.data());
+        const Lanes input = Lanes::load(r.inputGain.data());
+        const Lanes tapL = Lanes::load(r.tapLeft.data());
+        const Lanes tapR = Lanes::load(r.tapRight.data());
+        Lanes gain = Lanes::load(r.feedbackGain.data());
+        if constexpr (tier != Quality::Eco)
+            gain = Lanes::mul(gain, Lanes::set1(LINE_NORM));  // keeps the Hadamard matrix orthonormal
+        Lanes state = Lanes::load(r.dampState.data());
+
+        Lanes modCos = Lanes::load(r.modCos.data());
+        Lanes modSin = Lanes::load(r.modSin.data());
+        const Lanes stepCos = Lanes::load(r.modStepCos.data());
+        const Lanes stepSin = Lanes::load(r.modStepSin.data());
+        const Lanes depth = Lanes::set1(r.modDepth);
+        alignas(32) std::array<float, NUM_LINES> baseDelay;
+        for (size_t k = 0; k < NUM_LINES; ++k)
+            baseDelay[k] = static_cast<float>(r.lineDelays[k]);
+        const Lanes base = Lanes::load(baseDelay.data());
+
+        float* const lines = r.lines;
+        const int mask = r.frameMask;
+        const size_t mirror = static_cast<size_t>(mask + 1) * NUM_LINES;
+        int frame = r.writeFrame;
+        const std::array<int, NUM_LINES> readOffsets = r.readOffsets;
+
+        // Working copies, so the stores into the lines can't force reloads of the members
+        auto preDelay = r.preDelay;
+        const int preDelaySamples = r.preDelaySamples;
+        auto diffusers = r.diffusers;
+        const auto diffuserDelays = r.diffuserDelays;
+
+        const float filterCoeff = r.filterCoeff;
+        const float mix = r.mix;
+        float filterL = r.filterStateL;
+        float filterR = r.filterStateR;
+
+        alignas(32) std::array<float, NUM_LINES> positions;
+        std::array<int, NUM_LINES> offsets;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // Mono send through the pre-delay and diffusers
+            float x = preDelay.read(preDelaySamples);
+            preDelay.push(right != nullptr && !wetOnly ? (left[i] + right[i]) * 0.5f : left[i]);
+
+            for (size_t d = 0; d < static_cast<size_t>(numDiffusers); ++d)
+            {
+                const float delayed = diffusers[d].read(diffuserDelays[d]);
+                const float v = x + DIFFUSER_GAIN * delayed;
+                diffusers[d].push(v);
+                x = delayed - DIFFUSER_GAIN * v;
+            }
+
+            // Line outputs (a gather: each line reads its own delay back from the mirror)
+            const float* const newest = lines + static_cast<size_t>(frame) * NUM_LINES + mirror;
+            Lanes taps;
+            if constexpr (tier == Quality::High)
+            {
+                const Lanes position = Lanes::add(base, Lanes::mul(depth, modSin));
+                const Lanes nextCos = Lanes::sub(Lanes::mul(modCos, stepCos), Lanes::mul(modSin, stepSin));
+                modSin = Lanes::add(Lanes::mul(modSin, stepCos), Lanes::mul(modCos, stepSin));
+                modCos = nextCos;
+
+                Lanes::store(positions.data(), position);
+                for (size_t k = 0; k < NUM_LINES; ++k)
+                    offsets[k] = static_cast<int>(k) - static_cast<int>(positions[k]) * NUM_LINES;
+
+                const Lanes a = Lanes::gather(newest, offsets.data());
+                const Lanes b = Lanes::gather(newest - NUM_LINES, offsets.data());
+                taps = Lanes::add(a, Lanes::mul(Lanes::fraction(position), Lanes::sub(b, a)));
+            }
+            else
+            {
+                taps = Lanes::gather(newest, readOffsets.data());
+            }
+
+            // Damping lowpass in each line; the outputs tap the damped lines
+            state = Lanes::add(state, Lanes::mul(damp, Lanes::sub(taps, state)));
+            const float wetL = Lanes::sum(Lanes::mul(state, tapL));
+            const float wetR = Lanes::sum(Lanes::mul(state, tapR));
+
+            // Decay gain, feedback matrix, then the send
+            Lanes feedback = Lanes::mul(state, gain);
+            if constexpr (tier == Quality::Eco)
+                feedback = Lanes::sub(feedback, Lanes::set1(Lanes::sum(feedback) * HOUSEHOLDER_SCALE));
+            else
+                feedback = Lanes::hadamard(feedback);
+            feedback = Lanes::add(feedback, Lanes::mul(input, Lanes::set1(x)));
+
+            Lanes::store(lines + static_cast<size_t>(frame) * NUM_LINES, feedback);
+            Lanes::store(lines + static_cast<size_t>(frame) * NUM_LINES + mirror, feedback);
+            frame = (frame + 1) & mask;
+
+            // Lowpass the wet signal and blend dry/wet
+            filterL = filterL * filterCoeff + wetL * (1.0f - filterCoeff);
+            filterR = filterR * filterCoeff + wetR * (1.0f - filterCoeff);
+
+            if constexpr (wetOnly)
+            {
+                left[i] = filterL;
+                right[i] = filterR;
+                continue;
+            }
+
+            left[i] = left[i] * (1.0f - mix) + filterL * mix;
+            if (right != nullptr)
+                right[i] = right[i] * (1.0f - mix) + filterR * mix;
+        }
+
+        Lanes::store(r.dampState.data(), state);
+        r.writeFrame = frame;
+        r.preDelay = preDelay;
+        r.diffusers = diffusers;
+        r.filterStateL = filterL;
+        r.filterStateR = filterR;
+
+        if constexpr (tier == Quality::High)
+        {
+            // Pull the oscillators back onto the unit circle before rounding drifts them off
+            Lanes::store(r.modCos.data(), modCos);
+            Lanes::store(r.modSin.data(), modSin);
+            for (size_t k = 0; k < NUM_LINES; ++k)
+            {
+                const float scale = 1.5f - 0.5f * (r.modCos[k] * r.modCos[k] + r.modSin[k] * r.modSin[k]);
+                r.modCos[k] *= scale;
+                r.modSin[k] *= scale;
+            }
+        }
+    }
+
+    template <Quality tier, bool wetOnly>
+    static void processScalar(StereoReverb& r, float* left, float* right, int numSamples)
+    {
+        process<ScalarLanes, tier, wetOnly>(r, left, right, numSamples);
+    }
+
+   #if DFAM_FASTMATH_SSE2
+    template <Quality tier, bool wetOnly>
+    static void processSse2(StereoReverb& r, float* left, float* right, int numSamples)
+    {
+        process<Sse2Lanes, tier, wetOnly>(r, left, right, numSamples);
+    }
+   #endif
+
+   #if DFAM_FASTMATH_AVX2
+    template <Quality tier, bool wetOnly>
+    DFAM_TARGET_AVX2 static void processAvx2(StereoReverb& r, float* left, float* right, int numSamples)
+    {
+        process<Avx2Lanes, tier, wetOnly>(r, left, right, numSamples);
+    }
+   #endif
+
+    // Eight lanes fill an AVX2 register, so AVX-512 CPUs use the AVX2 loop
+    template <Quality tier, bool wetOnly>
+    static Kernel get(SimdDispatch::Variant variant)
+    {
+        using SimdDispatch::Variant;
+
+        switch (variant)
+        {
+           #if DFAM_FASTMATH_AVX2
+            case Variant::Avx512:
+            case Variant::Avx2:
+                return processAvx2<tier, wetOnly>;
+           #endif
+           #if DFAM_FASTMATH_SSE2
+            case Variant::Sse2:
+                return processSse2<tier, wetOnly>;
+           #endif
+            default:
+                return processScalar<tier, wetOnly>;
+        }
+    }
+
+    template <bool wetOnly>
+    static Kernel get(SimdDispatch::Variant variant, Quality tier)
+    {
+        return tier == Quality::Eco ? get<Quality::Eco, wetOnly>(variant)
+             : tier == Quality::Standard ? get<Quality::Standard, wetOnly>(variant) : get<Quality::High, wetOnly>(variant);
+    }
+
+    static Kernel get(const StereoReverb& r)
+    {
+        const auto variant = SimdDispatch::getKernels().variant;
+        return r.decimation > 1 ? get<true>(variant, r.quality) : get<false>(variant, r.quality);
+    }
+};
+
+// The network at the full host rate needs the most storage, so this covers every decimation
+int StereoReverb::getRequiredStorage(double sampleRate)
+{
+    int size = padded(2 * getFrameCount(sampleRate) * NUM_LINES) + padded(getPreDelaySize(sampleRate));
+    for (int d = 0; d < NUM_DIFFUSERS; ++d)
+        size += padded(getDiffuserSize(d, sampleRate));
+    return size;
+}
+
+void StereoReverb::prepare(double newSampleRate, float* newStorage)
+{
+    hostSampleRate = newSampleRate;
+    storage = newStorage;
+    configure(1);
+}
+
+void StereoReverb::configure(int newDecimation)
+{
+    decimation = newDecimation;
+    sampleRate = hostSampleRate / decimation;
+    float* next = storage;
+
+    const int frames = getFrameCount(sampleRate);
+    lines = next;
+    frameMask = frames - 1;
+    next += padded(2 * frames * NUM_LINES);
+
+    const int preDelaySize = getPreDelaySize(sampleRate);
+    preDelay.setBuffer(next, preDelaySize);
+    next += padded(preDelaySize);
+    preDelaySamples = std::min(static_cast<int>(sampleRate * PRE_DELAY_SECONDS), preDelay.getMaxDelay());
+
+    for (size_t d = 0; d < NUM_DIFFUSERS; ++d)
+    {
+        const int diffuserSize = getDiffuserSize(static_cast<int>(d), sampleRate);
+        diffusers[d].setBuffer(next, diffuserSize);
+        next += padded(diffuserSize);
+        diffuserDelays[d] = scaleLength(DIFFUSER_LENGTHS[d], sampleRate);
+    }
+
+    modDepth = static_cast<float>(sampleRate * MOD_DEPTH_SECONDS);
+    for (size_t k = 0; k < NUM_LINES; ++k)
+    {
+        lineDelays[k] = scaleLength(LINE_LENGTHS[k], sampleRate);
+        readOffsets[k] = static_cast<int>(k) - lineDelays[k] * NUM_LINES;
+        inputGain[k] = INPUT_SIGNS[k] * LINE_NORM;
+
+        const double step = juce::MathConstants<double>::twoPi * MOD_RATES_HZ[k] / sampleRate;
+        modStepCos[k] = static_cast<float>(std::cos(step));
+        modStepSin[k] = static_cast<float>(std::sin(step));
+    }
+
+    kernel = Kernels::get(*this);
+
+    // Recompute the line and wet lowpass coefficients for the new rate
+    const float currentDecay = decay;
+    decay = -1.0f;
+    if (currentDecay >= 0.0f)
+        setDecay(currentDecay);
+    if (filterCutoff >= 0.0f)
+        setFilterCutoff(filterCutoff);
+
+    reset();
+}
+
+void StereoReverb::reset()
+{
+    std::fill(lines, lines + static_cast<size_t>(frameMask + 1) * NUM_LINES * 2, 0.0f);
+    writeFrame = 0;
+    dampState.fill(0.0f);
+
+    preDelay.reset();
+    for (auto& diffuser : diffusers)
+        diffuser.reset();
+
+    // Each line's modulation starts at a different phase
+    for (size_t k = 0; k < NUM_LINES; ++k)
+    {
+        const float phase = static_cast<float>(k) / static_cast<float>(NUM_LINES);
+        modCos[k] = FastMath::cos2Pi(phase);
+        modSin[k] = FastMath::sin2Pi(phase);
+    }
+
+    filterStateL = 0.0f;
+    filterStateR = 0.0f;
+
+    for (size_t stage = 0; stage < 2; ++stage)
+    {
+        sendDecimators[stage].reset();
+        returnInterpolators[stage].reset();
+    }
+    queuedSends = 0;
+    queuedReturns = decimation;
+    std::fill(returnLeft.begin(), returnLeft.begin() + decimation, 0.0f);
+    std::fill(returnRight.begin(), returnRight.begin() + decimation, 0.0f);
+}
+
+void StereoReverb::setQuality(Quality newQuality)
+{
+    if (newQuality == quality)
+        return;
+
+    quality = newQuality;
+    kernel = Kernels::get(*this);
+}
+
+void StereoReverb::setDecay(float newDecay)
+{
+    if (newDecay == decay)
+        return;
+
+    decay = newDecay;
+
+    // Longer rooms are also darker (highs fall 2-5x faster)
+    const double t60 = getT60(decay);
+    const double t60High = t60 * (0.5 - 0.3 * decay);
+
+    for (size_t k = 0; k < NUM_LINES; ++k)
+    {
+        // Gain per pass for the line's length, at DC and at Nyquist. The damping lowpass
+        // (unity at DC) makes up the difference: its gain at Nyquist is a / (2 - a).
+        const double passes = lineDelays[k] / sampleRate;
+        const double gain = std::pow(10.0, -3.0 * passes / t60);
+        const double ratio = std::pow(10.0, -3.0 * passes / t60High) / gain;
+        feedbackGain[k] = static_cast<float>(gain);
+        dampCoeff[k] = static_cast<float>(2.0 * ratio / (1.0 + ratio));
+    }
+
+    // Stereo width (0.6 to 0.9) folded into the output taps
+    const float width = 0.6f + decay * 0.3f;
+    const float direct = 0.5f * (1.0f + width);
+    const float cross = 0.5f * (1.0f - width);
+    for (size_t k = 0; k < NUM_LINES; ++k)
+    {
+        tapLeft[k] = (direct * LEFT_SIGNS[k] + cross * RIGHT_SIGNS[k]) * LINE_NORM;
+        tapRight[k] = (direct * RIGHT_SIGNS[k] + cross * LEFT_SIGNS[k]) * LINE_NORM;
+    }
+}
+
+void StereoReverb::setFilterCutoff(float hz)
+{
+    filterCutoff = hz;
+    filterCoeff = std::exp(-2.0f * juce::MathConstants<float>::pi * hz / static_cast<float>(sampleRate));
+}
+
+int StereoReverb::chooseDecimation(float cutoff) const
+{
+    // Keep the current factor anywhere between the one the cutoff allows and the one it
+    // would allow a margin higher up
+    const int largest = getLargestDecimation(cutoff, hostSampleRate);
+    const int smallest = getLargestDecimation(cutoff * DECIMATION_HYSTERESIS, hostSampleRate);
+    return std::clamp(decimation, smallest, largest);
+}
+
+void StereoReverb::setDecimation(int newDecimation)
+{
+    jassert(newDecimation == 1 || newDecimation == 2 || newDecimation == MAX_DECIMATION);
+
+    if (newDecimation != decimation)
+        configure(newDecimation);
+}
+
+int StereoReverb::getTailHoldSamples() const
+{
+    int hold = preDelaySamples + lineDelays.back() + static_cast<int>(std::ceil(modDepth)) + 1;
+    for (const int delay : diffuserDelays)
+        hold += delay;
+    return hold * decimation + (decimation > 1 ? decimation : 0);
+}
+
+int StereoReverb::getDecaySamples() const
+{
+    return static_cast<int>(std::ceil(getT60(std::max(decay, 0.0f)) * hostSampleRate)) + getTailHoldSamples();
+}
+
+void StereoReverb::process(float* left, float* right, int numSamples)
+{
+    if (decimation == 1)
+    {
+        kernel(*this, left, right, numSamples);
+        return;
+    }
+
+    for (int start = 0; start < numSamples; start += CHUNK_SIZE)
+        processDecimated(left + start, right != nullptr ? right + start : nullptr, std::min(CHUNK_SIZE, numSamples - start));
+}
+
+void StereoReverb::processDecimated(float* left, float* right, int numSamples)
+{
+    // Mono send behind the samples left over from the last chunk
+    float* const send = sendQueue.data() + queuedSends;
+    if (right != nullptr)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            send[i] = (left[i] + right[i]) * 0.5f;
+    }
+    else
+    {
+        std::copy(left, left + numSamples, send);
+    }
+
+    const int numQueued = queuedSends + numSamples;
+    const int numNetwork = numQueued / decimation;
+    const int numUsed = numNetwork * decimation;
+
+    // Down to the network rate (a quarter goes through two halvings)
+    const float* queue[] = { sendQueue.data() };
+    float* network[] = { networkLeft.data() };  // the send, which the network replaces with its left output
+    sendDecimators[0].downsample(queue, network, numUsed / 2);
+    if (decimation == 4)
+        sendDecimators[1].downsample(network, network, numNetwork);
+
+    queuedSends = numQueued - numUsed;
+    std::copy(sendQueue.begin() + numUsed, sendQueue.begin() + numQueued, sendQueue.begin());
+
+    kernel(*this, networkLeft.data(), networkRight.data(), numNetwork);
+
+    // Back up to the host rate, behind the returns still queued
+    float* returns[] = { returnLeft.data() + queuedReturns, returnRight.data() + queuedReturns };
+    interpolate(returns, numNetwork);
+    const int numReturns = queuedReturns + numUsed;
+    jassert(numReturns >= numSamples);
+
+    juce::FloatVectorOperations::multiply(left, 1.0f - mix, numSamples);
+    juce::FloatVectorOperations::addWithMultiply(left, returnLeft.data(), mix, numSamples);
+    if (right != nullptr)
+    {
+        juce::FloatVectorOperations::multiply(right, 1.0f - mix, numSamples);
+        juce::FloatVectorOperations::addWithMultiply(right, returnRight.data(), mix, numSamples);
+    }
+
+    queuedReturns = numReturns - numSamples;
+    std::copy(returnLeft.begin() + numSamples, returnLeft.begin() + numReturns, returnLeft.begin());
+    std::copy(returnRight.begin() + numSamples, returnRight.begin() + numReturns, returnRight.begin());
+}
+
+void StereoReverb::interpolate(float* const* output, int numInput)
+{
+    const float* network[] = { networkLeft.data(), networkRight.data() };
+    if (decimation == 4)
+    {
+        float* half[] = { halfRateLeft.data(), halfRateRight.data() };
+        returnInterpolators[1].upsample(network, half, numInput);
+        returnInterpolators[0].upsample(half, output, numInput * 2);
+    }
+    else
+    {
+        returnInterpolators[0].upsample(network, output, numInput);
+    }
+}
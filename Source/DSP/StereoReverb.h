@@ -0,0 +1,140 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include "DelayLine.h"
+#include "HalfBandFilter.h"
+
+// The reverb stage: an eight-line feedback delay network.
+//
+// Each sample runs through everything in one pass:
+// - the 30 ms pre-delay and the input diffusers;
+// - the network itself: each line's damping lowpass and decay gain, then the feedback matrix;
+// - the wet lowpass and the dry/wet mix.
+//
+// The eight lines are processed as one SIMD vector (an AVX2 register or two SSE2 ones).
+// They are stored interleaved, eight floats per sample frame, so each sample writes all
+// eight lines with a single store. Mono input feeds the network; the left and right
+// outputs come from orthogonal taps of the lines. The frames are written twice, a buffer
+// length apart, so each line reads at a fixed offset from the newest frame without wrapping.
+//
+// Quality tiers trade echo density against CPU:
+//   Eco       Householder feedback, no input diffusion
+//   Standard  Hadamard feedback (every line feeds every other), two input diffusers
+//   High      as Standard with four input diffusers and slowly modulated line lengths
+//
+// When the wet lowpass leaves nothing in the top of the band (high host rates, low filter
+// settings) the network and the wet lowpass run at a half or a quarter of the host rate.
+// The send goes down and the wet signal comes back up through half-band filters; only the
+// mix runs at the host rate. chooseDecimation() picks the factor for a cutoff and
+// setDecimation() applies it; a change of factor clears the network, so a caller that
+// mustn't cut the tail lets the old network ring out in a second StereoReverb.
+class StereoReverb
+{
+public:
+    enum class Quality { Eco, Standard, High };
+
+    static constexpr int NUM_LINES = 8;
+    static constexpr int NUM_DIFFUSERS = 4;
+    static constexpr int MAX_DECIMATION = 4;
+
+    // Floats of storage prepare() needs: the network, the pre-delay and the diffusers
+    static int getRequiredStorage(double sampleRate);
+
+    // storage holds getRequiredStorage(sampleRate) floats; clears the reverb
+    void prepare(double sampleRate, float* storage);
+    void reset();
+
+    void setQuality(Quality newQuality);
+    void setDecay(float decay);  // 0 to 1
+    void setFilterCutoff(float hz);
+    void setMix(float newMix) { mix = newMix; }
+    float getMix() const { return mix; }
+
+    // Decimation for a wet lowpass cutoff. Moving to a larger factor needs the cutoff well
+    // inside the new band, so a cutoff held near a threshold doesn't flip the factor back
+    // and forth; a smaller one is taken as soon as the cutoff leaves the current band.
+    int chooseDecimation(float cutoff) const;
+    int getDecimation() const { return decimation; }
+
+    // 1, 2 or MAX_DECIMATION. A change re-lays the network out and clears it.
+    void setDecimation(int newDecimation);
+
+    // Samples the output can stay quiet while the reverb still holds input: the pre-delay,
+    // the diffusers and the longest line (and the resampling, when decimated)
+    int getTailHoldSamples() const;
+
+    // Host samples for the tail to fall 60 dB once the input stops
+    int getDecaySamples() const;
+
+    // In place; right is null for mono output
+    void process(float* left, float* right, int numSamples);
+
+private:
+    struct Kernels;  // per-instruction-set network loops, in the .cpp
+    using Kernel = void (*)(StereoReverb& reverb, float* left, float* right, int numSamples);
+
+    double hostSampleRate = 44100.0;
+    double sampleRate = 44100.0;  // the network's: the host rate over the decimation
+    int decimation = 1;
+    float* storage = nullptr;
+    Quality quality = Quality::Standard;
+    Kernel kernel = nullptr;
+
+    // Network: frames of NUM_LINES samples, a power of two of them, then a mirror copy
+    float* lines = nullptr;
+    int frameMask = 0;
+    int writeFrame = 0;
+    std::array<int, NUM_LINES> lineDelays = {};
+    std::array<int, NUM_LINES> readOffsets = {};  // each line's output, in floats from the mirrored write
+
+    // Per-line coefficients and state, one SIMD vector each
+    alignas(32) std::array<float, NUM_LINES> feedbackGain = {};
+    alignas(32) std::array<float, NUM_LINES> dampCoeff = {};
+    alignas(32) std::array<float, NUM_LINES> dampState = {};
+    alignas(32) std::array<float, NUM_LINES> inputGain = {};
+    alignas(32) std::array<float, NUM_LINES> tapLeft = {};
+    alignas(32) std::array<float, NUM_LINES> tapRight = {};
+
+    // High quality: each line's length swings by modDepth around lineDelays, driven by a
+    // quadrature oscillator per line (renormalised every block)
+    float modDepth = 0.0f;
+    alignas(32) std::array<float, NUM_LINES> modCos = {};
+    alignas(32) std::array<float, NUM_LINES> modSin = {};
+    alignas(32) std::array<float, NUM_LINES> modStepCos = {};
+    alignas(32) std::array<float, NUM_LINES> modStepSin = {};
+
+    DelayLine<float> preDelay;
+    int preDelaySamples = 0;
+
+    std::array<DelayLine<float>, NUM_DIFFUSERS> diffusers;
+    std::array<int, NUM_DIFFUSERS> diffuserDelays = {};
+
+    float decay = -1.0f;  // setDecay() value the coefficients were computed for
+    float filterCutoff = -1.0f;
+    float filterCoeff = 0.0f;
+    float filterStateL = 0.0f;
+    float filterStateR = 0.0f;
+    float mix = 0.0f;
+
+    // Decimated processing, a chunk at a time. Send samples short of a whole network sample
+    // wait in the queue for the next chunk; the wet return runs decimation samples behind,
+    // so a chunk's output is always there.
+    static constexpr int CHUNK_SIZE = 256;
+    std::array<HalfBandFilter<1>, 2> sendDecimators;     // host to half rate, half to quarter
+    std::array<HalfBandFilter<2>, 2> returnInterpolators;
+    std::array<float, CHUNK_SIZE + MAX_DECIMATION> sendQueue = {};
+    std::array<float, CHUNK_SIZE / 2 + MAX_DECIMATION> networkLeft = {};
+    std::array<float, CHUNK_SIZE / 2 + MAX_DECIMATION> networkRight = {};
+    std::array<float, CHUNK_SIZE / 2 + MAX_DECIMATION> halfRateLeft = {};
+    std::array<float, CHUNK_SIZE / 2 + MAX_DECIMATION> halfRateRight = {};
+    std::array<float, CHUNK_SIZE + 2 * MAX_DECIMATION> returnLeft = {};
+    std::array<float, CHUNK_SIZE + 2 * MAX_DECIMATION> returnRight = {};
+    int queuedSends = 0;
+    int queuedReturns = 0;
+
+    // Lay the network out in storage for the host rate over newDecimation, and clear it
+    void configure(int newDecimation);
+    void processDecimated(float* left, float* right, int numSamples);
+    void interpolate(float* const* output, int numInput);
+};
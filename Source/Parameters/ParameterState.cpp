@@ -0,0 +1,128 @@
+#include "ParameterState.h"
+
+juce::String Param::getID(int index)
+{
+    static const char* const scalarIDs[] = {
+        "vcoDecay", "seqPitchMod", "vco1EgAmt", "vco1Freq", "vco1Wave", "vco1Level", "subLevel", "noiseLevel",
+        "fmAmount", "hardSync", "vcoAntiAlias", "vcoWavetable", "oversampling",
+        "vco2EgAmt", "vco2Freq", "vco2Wave", "vco2Level",
+        "filterCutoff", "filterMode", "filterRes", "vcaEgMode", "vcaLevel",
+        "filterDecay", "filterEnvAmt", "noiseVcfMod", "vcaDecay",
+        "delayTime", "delayFeedback", "delayFilter", "delayMix", "delayMultiString",
+        "reverbDecay", "reverbFilter", "reverbMix", "reverbQuality", "reverbType",
+        "ringModFreq", "ringModMix",
+        "tempo", "tempoMult", "swing", "seqDirection", "hostSync", "seqRun", "glide", "drone", "midiHold",
+        "scaleType", "scaleRoot",
+        "lfoRate", "lfoWave", "lfoSync", "modRate"
+    };
+    static_assert(sizeof(scalarIDs) / sizeof(scalarIDs[0]) == seqPitch1, "Param ID table out of sync");
+
+    if (index < seqPitch1)
+        return scalarIDs[index];
+
+    // Grouped parameters: prefix + 1-based number
+    struct Group { int first; int count; const char* prefix; };
+    static const Group groups[] = {
+        { seqPitch1, NUM_SEQ_STEPS, "seqPitch" },
+        { seqVel1, NUM_SEQ_STEPS, "seqVel" },
+        { seqPan1, NUM_SEQ_STEPS, "seqPan" },
+        { seqWave1, NUM_SEQ_STEPS, "seqWave_" },
+        { seqRingMod1, NUM_SEQ_STEPS, "seqRingMod_" },
+        { seqDelayPitch1, NUM_SEQ_STEPS, "seqDelayPitch_" },
+        { modSrc1, NUM_MOD_SLOTS, "modSrc" },
+        { modDst1, NUM_MOD_SLOTS, "modDst" },
+        { modAmt1, NUM_MOD_SLOTS, "modAmt" }
+    };
+
+    for (const auto& group : groups)
+        if (index >= group.first && index < group.first + group.count)
+            return group.prefix + juce::String(index - group.first + 1);
+
+    jassertfalse;
+    return {};
+}
+
+// Flags one parameter's changes by its index, so the producer side never has to map
+// parameter ID strings back to indices. The APVTS has already stored the new value by the
+// time it calls this.
+struct ParameterState::Listener : public juce::AudioProcessorValueTreeState::Listener
+{
+    Listener(ParameterState& o, int i) : owner(o), index(i) {}
+
+    void parameterChanged(const juce::String&, float) override
+    {
+        owner.markChanged(index);
+    }
+
+    ParameterState& owner;
+    int index;
+};
+
+ParameterState::ParameterState(juce::AudioProcessorValueTreeState& state)
+    : apvts(state)
+{
+    for (auto& word : dirty)
+        word.store(0);
+
+    listeners.reserve(Param::NUM_PARAMS);
+
+    for (int i = 0; i < Param::NUM_PARAMS; ++i)
+    {
+        auto id = Param::getID(i);
+        rawValues[static_cast<size_t>(i)] = apvts.getRawParameterValue(id);
+        jassert(rawValues[static_cast<size_t>(i)] != nullptr);
+
+        listeners.push_back(std::make_unique<Listener>(*this, i));
+        apvts.addParameterListener(id, listeners.back().get());
+    }
+}
+
+ParameterState::~ParameterState()
+{
+    for (int i = 0; i < Param::NUM_PARAMS; ++i)
+        apvts.removeParameterListener(Param::getID(i), listeners[static_cast<size_t>(i)].get());
+}
+
+void ParameterState::reset()
+{
+    reloadPending.store(true);
+}
+
+void ParameterState::markChanged(int index)
+{
+    dirty[static_cast<size_t>(index / 64)].fetch_or(uint64_t { 1 } << (index % 64), std::memory_order_release);
+}
+
+void ParameterState::reloadAll()
+{
+    // Clear the flags first: the atomics already hold the flagged values, and anything
+    // changed after this point is applied normally
+    for (auto& word : dirty)
+        word.store(0, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < rawValues.size(); ++i)
+        snapshot.values[i] = rawValues[i]->load(std::memory_order_relaxed);
+}
+
+bool ParameterState::applyChanges()
+{
+    if (reloadPending.exchange(false))
+    {
+        reloadAll();
+        return true;
+    }
+
+    bool changed = false;
+
+    for (size_t word = 0; word < dirty.size(); ++word)
+    {
+        uint64_t bits = dirty[word].exchange(0, std::memory_order_acquire);
+        changed = changed || bits != 0;
+
+        for (size_t i = word * 64; bits != 0; ++i, bits >>= 1)
+            if ((bits & 1) != 0)
+                snapshot.values[i] = rawValues[i]->load(std::memory_order_relaxed);
+    }
+
+    return changed;
+}
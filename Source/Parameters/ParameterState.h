@@ -0,0 +1,113 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Dense indices for every APVTS parameter, so the audio thread can hold all of them in
+// one contiguous array instead of ~100 separately allocated atomics
+namespace Param
+{
+    constexpr int NUM_SEQ_STEPS = 8;
+    constexpr int NUM_MOD_SLOTS = 16;
+
+    enum Index
+    {
+        // VCO section
+        vcoDecay, seqPitchMod, vco1EgAmt, vco1Freq, vco1Wave, vco1Level, subLevel, noiseLevel,
+        fmAmount, hardSync, vcoAntiAlias, vcoWavetable, oversampling,
+        vco2EgAmt, vco2Freq, vco2Wave, vco2Level,
+
+        // Filter / VCA section
+        filterCutoff, filterMode, filterRes, vcaEgMode, vcaLevel,
+        filterDecay, filterEnvAmt, noiseVcfMod, vcaDecay,
+
+        // Delay, reverb, ring mod
+        delayTime, delayFeedback, delayFilter, delayMix, delayMultiString,
+        reverbDecay, reverbFilter, reverbMix, reverbQuality, reverbType,
+        ringModFreq, ringModMix,
+
+        // Sequencer
+        tempo, tempoMult, swing, seqDirection, hostSync, seqRun, glide, drone, midiHold,
+        scaleType, scaleRoot,
+
+        // LFO
+        lfoRate, lfoWave, lfoSync, modRate,
+
+        // Per-step parameters (NUM_SEQ_STEPS each)
+        seqPitch1,
+        seqVel1 = seqPitch1 + NUM_SEQ_STEPS,
+        seqPan1 = seqVel1 + NUM_SEQ_STEPS,
+        seqWave1 = seqPan1 + NUM_SEQ_STEPS,
+        seqRingMod1 = seqWave1 + NUM_SEQ_STEPS,
+        seqDelayPitch1 = seqRingMod1 + NUM_SEQ_STEPS,
+
+        // Mod slots (NUM_MOD_SLOTS each)
+        modSrc1 = seqDelayPitch1 + NUM_SEQ_STEPS,
+        modDst1 = modSrc1 + NUM_MOD_SLOTS,
+        modAmt1 = modDst1 + NUM_MOD_SLOTS,
+
+        NUM_PARAMS = modAmt1 + NUM_MOD_SLOTS
+    };
+
+    // APVTS parameter ID for an index
+    juce::String getID(int index);
+}
+
+// Plain copy of every parameter value, owned by the audio thread
+struct alignas(64) ParamSnapshot
+{
+    std::array<float, Param::NUM_PARAMS> values = {};
+
+    float operator[](int index) const { return values[static_cast<size_t>(index)]; }
+    bool getBool(int index) const { return values[static_cast<size_t>(index)] > 0.5f; }
+    int getInt(int index) const { return static_cast<int>(values[static_cast<size_t>(index)]); }
+};
+
+// Keeps a ParamSnapshot in sync with the APVTS without the render loop touching atomics.
+//
+// A parameter change only sets that parameter's bit in a dirty mask (one atomic OR, so any
+// thread can report changes without locking, the audio thread included when the host
+// automates from it). At each sub-block boundary the audio thread takes the mask and reads
+// the flagged parameters' current values from the APVTS. Changes that arrive while a block
+// is rendering (editor gestures, automation written from another thread) therefore take
+// effect within one sub-block instead of waiting for the next host block. JUCE's plugin
+// wrappers deliver host automation before processBlock without sample offsets, so those
+// changes land on the first sample of the block.
+//
+// The snapshot is reloaded in full from the APVTS on the first block and after reset().
+class ParameterState
+{
+public:
+    explicit ParameterState(juce::AudioProcessorValueTreeState& apvts);
+    ~ParameterState();
+
+    // Any thread: force a full reload at the next applyChanges()
+    void reset();
+
+    // Audio thread: apply queued changes. Returns true if the snapshot changed.
+    bool applyChanges();
+
+    const ParamSnapshot& getSnapshot() const { return snapshot; }
+
+private:
+    struct Listener;
+
+    juce::AudioProcessorValueTreeState& apvts;
+    std::array<std::atomic<float>*, Param::NUM_PARAMS> rawValues = {};
+    std::vector<std::unique_ptr<Listener>> listeners;
+
+    ParamSnapshot snapshot;
+
+    // Bit (index % 64) of word (index / 64) is set when that parameter has changed
+    static constexpr int NUM_DIRTY_WORDS = (Param::NUM_PARAMS + 63) / 64;
+    std::array<std::atomic<uint64_t>, NUM_DIRTY_WORDS> dirty;
+    std::atomic<bool> reloadPending { true };
+
+    void markChanged(int index);
+    void reloadAll();
+
+    JUCE_DECLARE_NON_COPYABLE(ParameterState)
+};
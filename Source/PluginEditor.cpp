@@ -89,6 +89,23 @@ DFAMSynthAudioProcessorEditor::DFAMSynthAudioProcessorEditor(DFAMSynthAudioProce
     };
     addAndMakeVisible(initPresetButton);
 
+    // Picks the convolution reverb's impulse response and switches the reverb over to it
+    loadImpulseButton.setButtonText("IR");
+    loadImpulseButton.onClick = [this, &apvts]() {
+        auto folder = audioProcessor.getReverbImpulse().getParentDirectory();
+        impulseChooser = std::make_unique<juce::FileChooser>("Load Impulse Response", folder, "*.wav;*.aif;*.aiff;*.flac");
+        impulseChooser->launchAsync(juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles,
+            [this, &apvts](const juce::FileChooser& chooser) {
+                auto file = chooser.getResult();
+                if (file.existsAsFile() && audioProcessor.loadReverbImpulse(file))
+                {
+                    if (auto* type = apvts.getParameter("reverbType"))
+                        type->setValueNotifyingHost(type->convertTo0to1(1.0f));
+                }
+            });
+    };
+    addAndMakeVisible(loadImpulseButton);
+
     // === ROW 1 Controls ===
     setupRotarySlider(vcoDecaySlider, vcoDecayLabel, "VCO DECAY");
 
@@ -130,6 +147,13 @@ DFAMSynthAudioProcessorEditor::DFAMSynthAudioProcessorEditor(DFAMSynthAudioProce
     setupRotarySlider(vco2FreqSlider, vco2FreqLabel, "VCO2 FREQ");
     setupRotarySlider(vco2WaveSlider, vco2WaveLabel, "VCO2 WAVE");
     setupRotarySlider(vco2LevelSlider, vco2LevelLabel, "VCO2 LEVEL");
+
+    vcoAntiAliasButton.setButtonText("ANTI-ALIAS");
+    addAndMakeVisible(vcoAntiAliasButton);
+
+    vcoWavetableButton.setButtonText("WAVETABLE");
+    addAndMakeVisible(vcoWavetableButton);
+
     setupRotarySlider(filterDecaySlider, filterDecayLabel, "VCF DECAY");
     setupRotarySlider(filterEnvAmtSlider, filterEnvAmtLabel, "VCF EG AMT");
     setupRotarySlider(noiseVcfModSlider, noiseVcfModLabel, "NOISE/VCF");
@@ -141,6 +165,9 @@ DFAMSynthAudioProcessorEditor::DFAMSynthAudioProcessorEditor(DFAMSynthAudioProce
     setupRotarySlider(delayFilterSlider, delayFilterLabel, "DLY FILT");
     setupRotarySlider(delayMixSlider, delayMixLabel, "DLY MIX");
 
+    delayMultiStringButton.setButtonText("MULTI-STRING");
+    addAndMakeVisible(delayMultiStringButton);
+
     // === RING MODULATOR Controls ===
     setupRotarySlider(ringModFreqSlider, ringFreqLabel, "RING FRQ");
     setupRotarySlider(ringModMixSlider, ringMixLabel, "RING MIX");
@@ -376,6 +403,8 @@ DFAMSynthAudioProcessorEditor::DFAMSynthAudioProcessorEditor(DFAMSynthAudioProce
     vco2FreqAtt = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(apvts, "vco2Freq", vco2FreqSlider);
     vco2WaveAtt = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(apvts, "vco2Wave", vco2WaveSlider);
     vco2LevelAtt = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(apvts, "vco2Level", vco2LevelSlider);
+    vcoAntiAliasAtt = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(apvts, "vcoAntiAlias", vcoAntiAliasButton);
+    vcoWavetableAtt = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(apvts, "vcoWavetable", vcoWavetableButton);
     filterDecayAtt = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(apvts, "filterDecay", filterDecaySlider);
     filterEnvAmtAtt = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(apvts, "filterEnvAmt", filterEnvAmtSlider);
     noiseVcfModAtt = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(apvts, "noiseVcfMod", noiseVcfModSlider);
@@ -390,6 +419,7 @@ DFAMSynthAudioProcessorEditor::DFAMSynthAudioProcessorEditor(DFAMSynthAudioProce
     delayFeedbackAtt = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(apvts, "delayFeedback", delayFeedbackSlider);
     delayFilterAtt = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(apvts, "delayFilter", delayFilterSlider);
     delayMixAtt = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(apvts, "delayMix", delayMixSlider);
+    delayMultiStringAtt = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(apvts, "delayMultiString", delayMultiStringButton);
 
     // Reverb attachments
     reverbDecayAtt = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(apvts, "reverbDecay", reverbDecaySlider);
@@ -421,6 +451,39 @@ DFAMSynthAudioProcessorEditor::DFAMSynthAudioProcessorEditor(DFAMSynthAudioProce
     addAndMakeVisible(droneButton);
     droneAtt = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(apvts, "drone", droneButton);
 
+    // Oversampling
+    oversamplingBox.addItem("1x", 1);
+    oversamplingBox.addItem("2x", 2);
+    oversamplingBox.addItem("4x", 3);
+    oversamplingBox.addItem("8x", 4);
+    addAndMakeVisible(oversamplingBox);
+    oversamplingLabel.setText("OS", juce::dontSendNotification);
+    oversamplingLabel.setJustificationType(juce::Justification::centred);
+    oversamplingLabel.setFont(juce::Font(10.0f));
+    addAndMakeVisible(oversamplingLabel);
+    oversamplingAtt = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(apvts, "oversampling", oversamplingBox);
+
+    // Reverb quality
+    reverbQualityBox.addItem("Eco", 1);
+    reverbQualityBox.addItem("Standard", 2);
+    reverbQualityBox.addItem("High", 3);
+    addAndMakeVisible(reverbQualityBox);
+    reverbQualityLabel.setText("RVB QUALITY", juce::dontSendNotification);
+    reverbQualityLabel.setJustificationType(juce::Justification::centred);
+    reverbQualityLabel.setFont(juce::Font(10.0f));
+    addAndMakeVisible(reverbQualityLabel);
+    reverbQualityAtt = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(apvts, "reverbQuality", reverbQualityBox);
+
+    // Reverb type
+    reverbTypeBox.addItem("Network", 1);
+    reverbTypeBox.addItem("Convolution", 2);
+    addAndMakeVisible(reverbTypeBox);
+    reverbTypeLabel.setText("RVB TYPE", juce::dontSendNotification);
+    reverbTypeLabel.setJustificationType(juce::Justification::centred);
+    reverbTypeLabel.setFont(juce::Font(10.0f));
+    addAndMakeVisible(reverbTypeLabel);
+    reverbTypeAtt = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(apvts, "reverbType", reverbTypeBox);
+
     // Scale quantization attachments
     scaleTypeAtt = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(apvts, "scaleType", scaleTypeBox);
     scaleRootAtt = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(apvts, "scaleRoot", scaleRootBox);
@@ -445,12 +508,29 @@ DFAMSynthAudioProcessorEditor::DFAMSynthAudioProcessorEditor(DFAMSynthAudioProce
     lfoSyncButton.setClickingTogglesState(true);
     addAndMakeVisible(lfoSyncButton);
 
+    modRateBox.addItem("Audio", 1);
+    modRateBox.addItem("16 Smp", 2);
+    modRateBox.addItem("32 Smp", 3);
+    modRateBox.addItem("64 Smp", 4);
+    addAndMakeVisible(modRateBox);
+    modRateLabel.setText("MOD RATE", juce::dontSendNotification);
+    modRateLabel.setJustificationType(juce::Justification::centred);
+    modRateLabel.setFont(juce::Font(10.0f));
+    addAndMakeVisible(modRateLabel);
+
     // Mod slots
     modMatrixLabel.setText("MOD MATRIX", juce::dontSendNotification);
     modMatrixLabel.setJustificationType(juce::Justification::centred);
     modMatrixLabel.setFont(juce::Font(11.0f, juce::Font::bold));
     addAndMakeVisible(modMatrixLabel);
 
+    // The four slot rows show one page of the matrix's slots at a time
+    for (int page = 0; page < Param::NUM_MOD_SLOTS / 4; ++page)
+        modPageBox.addItem(juce::String(page * 4 + 1) + "-" + juce::String(page * 4 + 4), page + 1);
+    modPageBox.setSelectedItemIndex(0, juce::dontSendNotification);
+    modPageBox.onChange = [this] { showModPage(modPageBox.getSelectedItemIndex()); };
+    addAndMakeVisible(modPageBox);
+
     for (int i = 0; i < 4; ++i)
     {
         // Source dropdown
@@ -489,15 +569,10 @@ DFAMSynthAudioProcessorEditor::DFAMSynthAudioProcessorEditor(DFAMSynthAudioProce
     lfoRateAtt = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(apvts, "lfoRate", lfoRateSlider);
     lfoWaveAtt = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(apvts, "lfoWave", lfoWaveBox);
     lfoSyncAtt = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(apvts, "lfoSync", lfoSyncButton);
+    modRateAtt = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(apvts, "modRate", modRateBox);
 
     // Mod slot attachments
-    for (int i = 0; i < 4; ++i)
-    {
-        juce::String num = juce::String(i + 1);
-        modSrcAtts[i] = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(apvts, "modSrc" + num, modSrcBoxes[i]);
-        modDstAtts[i] = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(apvts, "modDst" + num, modDstBoxes[i]);
-        modAmtAtts[i] = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(apvts, "modAmt" + num, modAmtSliders[i]);
-    }
+    showModPage(0);
 
     // MIDI Keyboard
     midiKeyboard.setOctaveForMiddleC(4);
@@ -567,6 +642,24 @@ void DFAMSynthAudioProcessorEditor::setupAutoRndComboBox(juce::ComboBox& box)
     addAndMakeVisible(box);
 }
 
+void DFAMSynthAudioProcessorEditor::showModPage(int page)
+{
+    auto& apvts = audioProcessor.getAPVTS();
+
+    for (int i = 0; i < 4; ++i)
+    {
+        // Detach from the previous page first so its parameters aren't written
+        modSrcAtts[i].reset();
+        modDstAtts[i].reset();
+        modAmtAtts[i].reset();
+
+        juce::String num = juce::String(page * 4 + i + 1);
+        modSrcAtts[i] = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(apvts, "modSrc" + num, modSrcBoxes[i]);
+        modDstAtts[i] = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(apvts, "modDst" + num, modDstBoxes[i]);
+        modAmtAtts[i] = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(apvts, "modAmt" + num, modAmtSliders[i]);
+    }
+}
+
 void DFAMSynthAudioProcessorEditor::updatePresetList()
 {
     presetBox.clear(juce::dontSendNotification);
@@ -725,6 +818,7 @@ void DFAMSynthAudioProcessorEditor::resized()
     int modY = 735;     // Mod Matrix
 
     // === PRESET Controls (top right in title bar) ===
+    loadImpulseButton.setBounds(getWidth() - 375, 10, 45, 26);
     presetBox.setBounds(getWidth() - 320, 10, 160, 26);
     initPresetButton.setBounds(getWidth() - 155, 10, 45, 26);
     savePresetButton.setBounds(getWidth() - 105, 10, 45, 26);
@@ -802,7 +896,10 @@ void DFAMSynthAudioProcessorEditor::resized()
     vco2LevelSlider.setBounds(x, row2Y + labelH, knobW, knobH);
     x += colW;
 
-    x += colW; // gap
+    // Oscillator engine switches in the gap column
+    vcoAntiAliasButton.setBounds(x + 8, row2Y + labelH + 10, knobW, 20);
+    vcoWavetableButton.setBounds(x + 8, row2Y + labelH + 40, knobW, 20);
+    x += colW;
 
     filterDecayLabel.setBounds(x, row2Y, knobW, labelH);
     filterDecaySlider.setBounds(x, row2Y + labelH, knobW, knobH);
@@ -822,7 +919,8 @@ void DFAMSynthAudioProcessorEditor::resized()
     // === ROW 3: FX (Delay | Ring Mod | Reverb | LFO) ===
     x = margin;
 
-    // DELAY
+    // DELAY (multi-string switch in the section header, after its label)
+    delayMultiStringButton.setBounds(x + 70, row3Y - 3, 120, 16);
     delayTimeLabel.setBounds(x, row3Y + 12, knobW, labelH);
     delayTimeSlider.setBounds(x, row3Y + 12 + labelH, knobW, knobH);
     x += colW;
@@ -861,6 +959,12 @@ void DFAMSynthAudioProcessorEditor::resized()
     reverbMixSlider.setBounds(x, row3Y + 12 + labelH, knobW, knobH);
     x += colW + 15;
 
+    // Reverb engine settings after the reverb knobs
+    reverbQualityLabel.setBounds(x, row3Y + 12, 110, labelH);
+    reverbQualityBox.setBounds(x, row3Y + 12 + labelH, 110, 24);
+    reverbTypeLabel.setBounds(x, row3Y + 55, 110, labelH);
+    reverbTypeBox.setBounds(x, row3Y + 55 + labelH, 110, 24);
+
     // LFO controls moved to Mod Matrix section below
 
     // === TRANSPORT ROW ===
@@ -887,6 +991,10 @@ void DFAMSynthAudioProcessorEditor::resized()
     glideLabel.setBounds(x, transY + 12, 50, 20);
     glideSlider.setBounds(x + 55, transY + 10, 100, 24);
     droneButton.setBounds(x + 160, transY + 8, 70, 28);
+    x += 245;
+
+    oversamplingLabel.setBounds(x, transY + 12, 30, 20);
+    oversamplingBox.setBounds(x + 35, transY + 8, 60, 28);
 
     // === SEQUENCER Layout ===
     const int seqRowH = 42;
@@ -965,7 +1073,8 @@ void DFAMSynthAudioProcessorEditor::resized()
     autoRndDelayPitchBox.setBounds(rndX + rndBtnW + 5, rowY + 4, autoRndW, 22);
 
     // === MOD MATRIX Layout (2 rows of 2 slots) ===
-    modMatrixLabel.setBounds(margin, modY + 5, 100, 20);
+    modMatrixLabel.setBounds(margin, modY + 5, 75, 20);
+    modPageBox.setBounds(margin + 75, modY + 5, 75, 20);
 
     // LFO controls on the left
     lfoRateLabel.setBounds(margin, modY + 28, 60, 14);
@@ -999,6 +1108,11 @@ void DFAMSynthAudioProcessorEditor::resized()
         modAmtSliders[i].setBounds(slotX + srcDstW * 2 + 10, modRow2Y, amtW, 24);
     }
 
+    // Matrix rate, right of the slots
+    const int modRateX = slotStartX + 2 * slotSpacing + 10;
+    modRateLabel.setBounds(modRateX, modRow1Y, 60, 24);
+    modRateBox.setBounds(modRateX + 65, modRow1Y, 85, 24);
+
     // === MIDI Keyboard ===
     int midiY = modY + 115;
     midiHoldButton.setBounds(margin, midiY, 55, 50);
@@ -24,6 +24,10 @@ private:
     juce::TextButton initPresetButton;
     void updatePresetList();
 
+    // Convolution reverb impulse response
+    juce::TextButton loadImpulseButton;
+    std::unique_ptr<juce::FileChooser> impulseChooser;
+
     // === ROW 1 ===
     juce::Slider vcoDecaySlider;
     juce::ComboBox seqPitchModBox;
@@ -46,6 +50,8 @@ private:
     juce::Slider vco2FreqSlider;
     juce::Slider vco2WaveSlider;
     juce::Slider vco2LevelSlider;
+    juce::ToggleButton vcoAntiAliasButton;
+    juce::ToggleButton vcoWavetableButton;
     juce::Slider filterDecaySlider;
     juce::Slider filterEnvAmtSlider;
     juce::Slider noiseVcfModSlider;
@@ -56,6 +62,7 @@ private:
     juce::Slider delayFeedbackSlider;
     juce::Slider delayFilterSlider;
     juce::Slider delayMixSlider;
+    juce::ToggleButton delayMultiStringButton;
 
     // === REVERB ===
     juce::Slider reverbDecaySlider;
@@ -129,6 +136,8 @@ private:
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> vco2FreqAtt;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> vco2WaveAtt;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> vco2LevelAtt;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> vcoAntiAliasAtt;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> vcoWavetableAtt;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> filterDecayAtt;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> filterEnvAmtAtt;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> noiseVcfModAtt;
@@ -149,6 +158,7 @@ private:
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> delayFeedbackAtt;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> delayFilterAtt;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> delayMixAtt;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> delayMultiStringAtt;
 
     // Reverb attachments
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> reverbDecayAtt;
@@ -171,6 +181,21 @@ private:
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> glideAtt;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> droneAtt;
 
+    // Oversampling of the oscillator -> filter section
+    juce::ComboBox oversamplingBox;
+    juce::Label oversamplingLabel;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> oversamplingAtt;
+
+    // Reverb network quality tier (echo density against CPU)
+    juce::ComboBox reverbQualityBox;
+    juce::Label reverbQualityLabel;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> reverbQualityAtt;
+
+    // Reverb engine: the network, or the impulse response loaded with the IR button
+    juce::ComboBox reverbTypeBox;
+    juce::Label reverbTypeLabel;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> reverbTypeAtt;
+
     // Scale quantization
     juce::ComboBox scaleTypeBox;
     juce::ComboBox scaleRootBox;
@@ -190,7 +215,14 @@ private:
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> lfoWaveAtt;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> lfoSyncAtt;
 
-    // Mod slots (4 slots)
+    // Rate the matrix is evaluated at
+    juce::ComboBox modRateBox;
+    juce::Label modRateLabel;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> modRateAtt;
+
+    // Mod slots (4 rows, paged across the processor's slots)
+    juce::ComboBox modPageBox;
+    void showModPage(int page);
     std::array<juce::ComboBox, 4> modSrcBoxes;
     std::array<juce::ComboBox, 4> modDstBoxes;
     std::array<juce::Slider, 4> modAmtSliders;
@@ -1,98 +1,27 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "DSP/FastMath.h"
+#include <random>
+#include <utility>
 
 DFAMSynthAudioProcessor::DFAMSynthAudioProcessor()
     : AudioProcessor(BusesProperties()
                      .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , apvts(*this, nullptr, "Parameters", createParameterLayout())
+    , parameters(apvts)
 {
-    // Cache parameter pointers - VCO section
-    vcoDecayParam = apvts.getRawParameterValue("vcoDecay");
-    seqPitchModParam = apvts.getRawParameterValue("seqPitchMod");
-    vco1EgAmtParam = apvts.getRawParameterValue("vco1EgAmt");
-    vco1FreqParam = apvts.getRawParameterValue("vco1Freq");
-    vco1WaveParam = apvts.getRawParameterValue("vco1Wave");
-    vco1LevelParam = apvts.getRawParameterValue("vco1Level");
-    subLevelParam = apvts.getRawParameterValue("subLevel");
-    noiseLevelParam = apvts.getRawParameterValue("noiseLevel");
-
-    fmAmountParam = apvts.getRawParameterValue("fmAmount");
-    hardSyncParam = apvts.getRawParameterValue("hardSync");
-    vco2EgAmtParam = apvts.getRawParameterValue("vco2EgAmt");
-    vco2FreqParam = apvts.getRawParameterValue("vco2Freq");
-    vco2WaveParam = apvts.getRawParameterValue("vco2Wave");
-    vco2LevelParam = apvts.getRawParameterValue("vco2Level");
-
-    // Filter section
-    filterCutoffParam = apvts.getRawParameterValue("filterCutoff");
-    filterModeParam = apvts.getRawParameterValue("filterMode");
-    filterResParam = apvts.getRawParameterValue("filterRes");
-    vcaEgModeParam = apvts.getRawParameterValue("vcaEgMode");
-    vcaLevelParam = apvts.getRawParameterValue("vcaLevel");
-
-    filterDecayParam = apvts.getRawParameterValue("filterDecay");
-    filterEnvAmtParam = apvts.getRawParameterValue("filterEnvAmt");
-    noiseVcfModParam = apvts.getRawParameterValue("noiseVcfMod");
-    vcaDecayParam = apvts.getRawParameterValue("vcaDecay");
-
-    // Sequencer
-    tempoParam = apvts.getRawParameterValue("tempo");
-    tempoMultParam = apvts.getRawParameterValue("tempoMult");
-    seqRunParam = apvts.getRawParameterValue("seqRun");
-    glideParam = apvts.getRawParameterValue("glide");
-    droneParam = apvts.getRawParameterValue("drone");
-    midiHoldParam = apvts.getRawParameterValue("midiHold");
+    // Each instance starts from its own seed; saving the state pins it. A local
+    // random_device rather than the shared juce::Random, which isn't safe to use from
+    // hosts that create instances on several threads at once.
+    setRandomSeed(std::random_device{}());
 
-    for (int i = 0; i < 8; ++i)
-    {
-        seqPitchParams[i] = apvts.getRawParameterValue("seqPitch" + juce::String(i + 1));
-        seqVelParams[i] = apvts.getRawParameterValue("seqVel" + juce::String(i + 1));
-        seqPanParams[i] = apvts.getRawParameterValue("seqPan" + juce::String(i + 1));
-        seqWaveParams[i] = apvts.getRawParameterValue("seqWave_" + juce::String(i + 1));
-        seqRingModParams[i] = apvts.getRawParameterValue("seqRingMod_" + juce::String(i + 1));
-        seqDelayPitchParams[i] = apvts.getRawParameterValue("seqDelayPitch_" + juce::String(i + 1));
-    }
-
-    // Delay
-    delayTimeParam = apvts.getRawParameterValue("delayTime");
-    delayFeedbackParam = apvts.getRawParameterValue("delayFeedback");
-    delayFilterParam = apvts.getRawParameterValue("delayFilter");
-    delayMixParam = apvts.getRawParameterValue("delayMix");
-
-    // Reverb
-    reverbDecayParam = apvts.getRawParameterValue("reverbDecay");
-    reverbFilterParam = apvts.getRawParameterValue("reverbFilter");
-    reverbMixParam = apvts.getRawParameterValue("reverbMix");
-
-    // Sequencer swing/direction
-    swingParam = apvts.getRawParameterValue("swing");
-    seqDirectionParam = apvts.getRawParameterValue("seqDirection");
-    hostSyncParam = apvts.getRawParameterValue("hostSync");
-
-    // Ring modulator
-    ringModFreqParam = apvts.getRawParameterValue("ringModFreq");
-    ringModMixParam = apvts.getRawParameterValue("ringModMix");
-
-    // Scale quantization
-    scaleTypeParam = apvts.getRawParameterValue("scaleType");
-    scaleRootParam = apvts.getRawParameterValue("scaleRoot");
-
-    // Mod matrix
-    lfoRateParam = apvts.getRawParameterValue("lfoRate");
-    lfoWaveParam = apvts.getRawParameterValue("lfoWave");
-    lfoSyncParam = apvts.getRawParameterValue("lfoSync");
-
-    for (int i = 0; i < NUM_MOD_SLOTS; ++i)
-    {
-        juce::String num = juce::String(i + 1);
-        modSrcParams[i] = apvts.getRawParameterValue("modSrc" + num);
-        modDstParams[i] = apvts.getRawParameterValue("modDst" + num);
-        modAmtParams[i] = apvts.getRawParameterValue("modAmt" + num);
-    }
+    // Pick the SIMD kernels now rather than on the first audio callback
+    SimdDispatch::getKernels();
 }
 
 DFAMSynthAudioProcessor::~DFAMSynthAudioProcessor()
 {
+    cancelPendingUpdate();
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout DFAMSynthAudioProcessor::createParameterLayout()
@@ -160,6 +89,19 @@ juce::AudioProcessorValueTreeState::ParameterLayout DFAMSynthAudioProcessor::cre
     params.push_back(std::make_unique<juce::AudioParameterBool>(
         juce::ParameterID("hardSync", 1), "Hard Sync", false));
 
+    // Band-limited (PolyBLEP) oscillators; off = naive waveforms
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID("vcoAntiAlias", 1), "VCO Anti-Alias", true));
+
+    // Wavetable engine: morph read from a prebuilt band-limited table
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID("vcoWavetable", 1), "VCO Wavetable", false));
+
+    // Oversampling for the oscillator -> filter section (FX stay at the host rate)
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID("oversampling", 1), "Oversampling",
+        juce::StringArray("1x", "2x", "4x", "8x"), 0));
+
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID("vco2EgAmt", 1), "VCO2 EG Amount",
         juce::NormalisableRange<float>(-1.0f, 1.0f, 0.01f), 0.0f));
@@ -210,6 +152,10 @@ juce::AudioProcessorValueTreeState::ParameterLayout DFAMSynthAudioProcessor::cre
         juce::ParameterID("delayMix", 1), "Delay Mix",
         juce::NormalisableRange<float>(0.0f, 1.0f), 0.0f));
 
+    // Three detuned strings per step instead of one
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID("delayMultiString", 1), "Delay Multi-String", false));
+
     // ===== REVERB =====
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID("reverbDecay", 1), "Reverb Decay",
@@ -223,6 +169,16 @@ juce::AudioProcessorValueTreeState::ParameterLayout DFAMSynthAudioProcessor::cre
         juce::ParameterID("reverbMix", 1), "Reverb Mix",
         juce::NormalisableRange<float>(0.0f, 1.0f), 0.0f));
 
+    // Reverb density against CPU (see StereoReverb)
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID("reverbQuality", 1), "Reverb Quality",
+        juce::StringArray("Eco", "Standard", "High"), 1));
+
+    // Reverb engine: the delay network, or the loaded impulse response (see ConvolutionReverb)
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID("reverbType", 1), "Reverb Type",
+        juce::StringArray("Network", "Convolution"), 0));
+
     // ===== RING MODULATOR =====
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID("ringModFreq", 1), "Ring Mod Freq",
@@ -322,10 +278,15 @@ juce::AudioProcessorValueTreeState::ParameterLayout DFAMSynthAudioProcessor::cre
     params.push_back(std::make_unique<juce::AudioParameterBool>(
         juce::ParameterID("lfoSync", 1), "LFO Tempo Sync", false));
 
-    // Mod slots (4 slots, each with source, destination, amount)
+    // Mod matrix evaluation rate: every sample, or once per N samples with linear ramps
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID("modRate", 1), "Mod Rate",
+        juce::StringArray("Audio", "16 Samples", "32 Samples", "64 Samples"), 0));
+
+    // Mod slots (16 slots, each with source, destination, amount)
     // Sources: OFF, LFO, Pitch Env, Filter Env, VCA Env, Velocity, Random
     // Destinations: OFF, Flt Cut, Flt Res, VCO1 Pitch, VCO2 Pitch, Ring Freq, Pan, VCO1 Level, VCO2 Level
-    for (int i = 0; i < 4; ++i)
+    for (int i = 0; i < Param::NUM_MOD_SLOTS; ++i)
     {
         juce::String num = juce::String(i + 1);
 
@@ -353,40 +314,76 @@ const juce::String DFAMSynthAudioProcessor::getName() const
 bool DFAMSynthAudioProcessor::acceptsMidi() const { return true; }
 bool DFAMSynthAudioProcessor::producesMidi() const { return false; }
 bool DFAMSynthAudioProcessor::isMidiEffect() const { return false; }
-double DFAMSynthAudioProcessor::getTailLengthSeconds() const { return 0.0; }
+double DFAMSynthAudioProcessor::getTailLengthSeconds() const { return tailLengthSeconds.load(std::memory_order_relaxed); }
 int DFAMSynthAudioProcessor::getNumPrograms() { return 1; }
 int DFAMSynthAudioProcessor::getCurrentProgram() { return 0; }
 void DFAMSynthAudioProcessor::setCurrentProgram(int) {}
 const juce::String DFAMSynthAudioProcessor::getProgramName(int) { return {}; }
 void DFAMSynthAudioProcessor::changeProgramName(int, const juce::String&) {}
 
-void DFAMSynthAudioProcessor::prepareToPlay(double sampleRate, int /*samplesPerBlock*/)
+void DFAMSynthAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
     currentSampleRate = sampleRate;
 
-    vco1.prepare(sampleRate);
-    vco2.prepare(sampleRate);
-    subOsc.prepare(sampleRate);
+    // Fresh parameter snapshot (the audio thread isn't running during prepareToPlay)
+    parameters.reset();
+    parameters.applyChanges();
+    oversamplingOrder = std::clamp(parameters.getSnapshot().getInt(Param::oversampling), 0, MAX_OVERSAMPLING_ORDER);
+    pendingOversamplingOrder = oversamplingOrder;
+    oversamplingFadeGain = 1.0f;
+    oversamplingFadeStep = 1.0f / static_cast<float>(std::max(1, static_cast<int>(sampleRate * OVERSAMPLING_FADE_SECONDS)));
+    voiceLatency.store(prepareVoiceSampleRate());
+    cancelPendingUpdate();
+    setLatencySamples(voiceLatency.load());
+
     noise.prepare(sampleRate);
-    filter.prepare(sampleRate);
+    applyRandomSeed(randomSeed.load());
     pitchEnv.prepare(sampleRate);
     filterEnv.prepare(sampleRate);
     vcaEnv.prepare(sampleRate);
     sequencer.prepare(sampleRate);
-
-    // Initialize delay buffer (max 2 seconds)
-    delayBufferSize = static_cast<int>(sampleRate * 2.0);
-    delayBuffer.resize(delayBufferSize, 0.0f);
-    delayWritePos = 0;
-
-    // Initialize reverb
-    reverb.setSampleRate(sampleRate);
-
-    // Initialize reverb pre-delay buffer (max 100ms)
-    reverbPreDelaySize = static_cast<int>(sampleRate * 0.1);
-    reverbPreDelayL.resize(reverbPreDelaySize, 0.0f);
-    reverbPreDelayR.resize(reverbPreDelaySize, 0.0f);
-    reverbPreDelayWritePos = 0;
+    panner.prepare(sampleRate);
+
+    // Start from the same voice state every time, so renders with the same seed repeat exactly
+    lfoPhase = 0.0;
+    currentGlidePitch = 0.0f;
+    targetGlidePitch = 0.0f;
+    smoothedWave1 = 0.33f;
+    smoothedWave2 = 0.33f;
+    midiNotePitch = 0.0f;
+    midiNoteActive = false;
+    lastMidiNote = -1;
+
+    // Restart control-rate modulation ramps
+    modRampValues = {};
+    modRampTargets = {};
+    modRampIncrements = {};
+    modSamplesUntilUpdate = 0;
+
+    // Delay (max 2 seconds), both reverbs and the FX fade buffers share one zeroed allocation
+    maxBlockSize = std::max(samplesPerBlock, SUB_BLOCK_SIZE);
+
+    const auto padded = [](int numFloats) { return ScratchArena::getPaddedSize(static_cast<size_t>(numFloats)); };
+    const int resonatorSize = KarplusStrong::getRequiredStorage(sampleRate);
+    const int reverbSize = StereoReverb::getRequiredStorage(sampleRate);
+    const int convolutionSize = ConvolutionReverb::getRequiredStorage(maxBlockSize);
+    arena.allocate(padded(resonatorSize) + 2 * padded(reverbSize) + padded(convolutionSize) + 2 * padded(maxBlockSize * 2));
+
+    resonator.prepare(sampleRate, arena.take(static_cast<size_t>(resonatorSize)));
+    reverb.prepare(sampleRate, arena.take(static_cast<size_t>(reverbSize)));
+    ringingReverb.prepare(sampleRate, arena.take(static_cast<size_t>(reverbSize)));
+    convolutionReverb.prepare(sampleRate, maxBlockSize, arena.take(static_cast<size_t>(convolutionSize)));
+    ringMod.prepare(sampleRate);
+
+    float* fxFadeBuffer = arena.take(static_cast<size_t>(maxBlockSize * 2));
+    for (auto& stage : fxStages)
+        stage.prepare(sampleRate, maxBlockSize, fxFadeBuffer);
+
+    reverbCrossfadeLeft = arena.take(static_cast<size_t>(maxBlockSize * 2));
+    reverbCrossfadeRight = reverbCrossfadeLeft + maxBlockSize;
+    reverbCrossfadeLength = std::max(1, static_cast<int>(sampleRate * REVERB_CROSSFADE_SECONDS));
+    reverbCrossfadeRemaining = 0;
+    reverbRingOutRemaining = 0;
 }
 
 void DFAMSynthAudioProcessor::releaseResources()
@@ -411,7 +408,7 @@ float DFAMSynthAudioProcessor::generateLFO(float waveform)
     switch (wave)
     {
         case 0:  // Sine
-            return std::sin(phase * 2.0f * juce::MathConstants<float>::pi);
+            return FastMath::sin2Pi(phase);
 
         case 1:  // Triangle
             if (phase < 0.25f)
@@ -432,12 +429,10 @@ float DFAMSynthAudioProcessor::generateLFO(float waveform)
 
         case 5:  // Sample & Hold (random value held until next cycle)
         {
-            static float shValue = 0.0f;
-            static float lastPhase = 0.0f;
-            if (phase < lastPhase)  // Phase wrapped, new random value
-                shValue = (static_cast<float>(rand()) / RAND_MAX) * 2.0f - 1.0f;
-            lastPhase = phase;
-            return shValue;
+            if (phase < lfoLastPhase)  // Phase wrapped, new random value
+                lfoHoldValue = lfoRandom.nextBipolar();
+            lfoLastPhase = phase;
+            return lfoHoldValue;
         }
 
         default:
@@ -451,24 +446,30 @@ float DFAMSynthAudioProcessor::quantizePitchToScale(float pitchSemitones, int sc
     if (scaleType == 0)
         return pitchSemitones;
 
-    // Scale intervals (semitones from root)
-    static const std::vector<std::vector<int>> scales = {
-        {},                                    // 0: OFF (not used)
-        {0, 2, 4, 5, 7, 9, 11},                // 1: Major
-        {0, 2, 3, 5, 7, 8, 10},                // 2: Natural Minor
-        {0, 2, 3, 5, 7, 8, 11},                // 3: Harmonic Minor
-        {0, 2, 4, 7, 9},                       // 4: Pentatonic Major
-        {0, 3, 5, 7, 10},                      // 5: Pentatonic Minor
-        {0, 3, 5, 6, 7, 10},                   // 6: Blues
-        {0, 2, 3, 5, 7, 9, 10},                // 7: Dorian
-        {0, 1, 3, 5, 7, 8, 10},                // 8: Phrygian
-        {0, 2, 4, 6, 7, 9, 11},                // 9: Lydian
-        {0, 2, 4, 5, 7, 9, 10},                // 10: Mixolydian
-        {0, 1, 3, 5, 6, 8, 10},                // 11: Locrian
-        {0, 2, 4, 6, 8, 10}                    // 12: Whole Tone
+    // Scale intervals (semitones from root). Fixed-size so the audio thread never
+    // allocates on first use.
+    struct Scale
+    {
+        int numNotes;
+        int notes[7];
+    };
+    static constexpr Scale scales[] = {
+        { 0, {} },                              // 0: OFF (not used)
+        { 7, {0, 2, 4, 5, 7, 9, 11} },          // 1: Major
+        { 7, {0, 2, 3, 5, 7, 8, 10} },          // 2: Natural Minor
+        { 7, {0, 2, 3, 5, 7, 8, 11} },          // 3: Harmonic Minor
+        { 5, {0, 2, 4, 7, 9} },                 // 4: Pentatonic Major
+        { 5, {0, 3, 5, 7, 10} },                // 5: Pentatonic Minor
+        { 6, {0, 3, 5, 6, 7, 10} },             // 6: Blues
+        { 7, {0, 2, 3, 5, 7, 9, 10} },          // 7: Dorian
+        { 7, {0, 1, 3, 5, 7, 8, 10} },          // 8: Phrygian
+        { 7, {0, 2, 4, 6, 7, 9, 11} },          // 9: Lydian
+        { 7, {0, 2, 4, 5, 7, 9, 10} },          // 10: Mixolydian
+        { 7, {0, 1, 3, 5, 6, 8, 10} },          // 11: Locrian
+        { 6, {0, 2, 4, 6, 8, 10} }              // 12: Whole Tone
     };
 
-    if (scaleType < 1 || scaleType >= static_cast<int>(scales.size()))
+    if (scaleType < 1 || scaleType >= static_cast<int>(std::size(scales)))
         return pitchSemitones;
 
     const auto& scale = scales[scaleType];
@@ -491,8 +492,9 @@ float DFAMSynthAudioProcessor::quantizePitchToScale(float pitchSemitones, int sc
     float minDistance = 100.0f;
     int closestNote = 0;
 
-    for (int note : scale)
+    for (int n = 0; n < scale.numNotes; ++n)
     {
+        const int note = scale.notes[n];
         float distance = std::abs(noteInOctave - static_cast<float>(note));
         // Also check wrapping (e.g., 11.5 should snap to 0 of next octave)
         float wrapDistance = std::abs(noteInOctave - (static_cast<float>(note) + 12.0f));
@@ -521,202 +523,529 @@ float DFAMSynthAudioProcessor::quantizePitchToScale(float pitchSemitones, int sc
     return quantizedPitch;
 }
 
-void DFAMSynthAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
-                                            juce::MidiBuffer& midiMessages)
+int DFAMSynthAudioProcessor::prepareVoiceSampleRate()
 {
-    juce::ScopedNoDenormals noDenormals;
+    // Oscillators and filter run at the oversampled rate, everything else at the host rate
+    const double voiceSampleRate = currentSampleRate * (1 << oversamplingOrder);
+    oscillators.prepare(voiceSampleRate);
+    filter.prepare(voiceSampleRate);
+
+    for (auto& decimator : decimators)
+        decimator.reset();
+
+    // Each halving delays by the decimator's delay at its own output rate, so the last one
+    // counts in full, the one before it half, and so on
+    double latency = 0.0;
+    for (int stage = 0; stage < oversamplingOrder; ++stage)
+        latency += HalfBandFilter<1>::getDownsampleDelay() / (1 << stage);
+    return juce::roundToInt(latency);
+}
 
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
+void DFAMSynthAudioProcessor::switchOversampling()
+{
+    // Called on the audio thread once the voice is silent, so the restart can't click;
+    // setLatencySamples waits for the message thread
+    oversamplingOrder = pendingOversamplingOrder;
+    voiceLatency.store(prepareVoiceSampleRate());
+    triggerAsyncUpdate();
+}
 
-    // Clear buffer
-    for (auto i = 0; i < totalNumOutputChannels; ++i)
-        buffer.clear(i, 0, buffer.getNumSamples());
+void DFAMSynthAudioProcessor::handleAsyncUpdate()
+{
+    setLatencySamples(voiceLatency.load());
+}
 
-    // Process MIDI messages
-    keyboardState.processNextMidiBuffer(midiMessages, 0, buffer.getNumSamples(), true);
+void DFAMSynthAudioProcessor::renderOscillatorsAndFilter(int numSamples, bool hardSync, float subLevel)
+{
+    // A pending oversampling change takes over once the fade below has reached silence
+    if (pendingOversamplingOrder != oversamplingOrder && oversamplingFadeGain <= 0.0f)
+        switchOversampling();
+
+    const int factor = 1 << oversamplingOrder;
+    const bool oversampled = oversamplingOrder > 0;
+
+    // At 1x the filter works straight on the base-rate buffers
+    float* input = filterInputBuffer.data();
+    const float* cutoff = filterCutoffBuffer.data();
+    const float* resonance = filterResBuffer.data();
+    float* output = filterOutputBuffer.data();
 
-    for (const auto metadata : midiMessages)
+    if (oversampled)
     {
-        auto message = metadata.getMessage();
+        input = oversampledBuffer.data();
+        output = input;
+        cutoff = oversampledCutoffBuffer.data();
+        resonance = oversampledResBuffer.data();
+    }
 
-        if (message.isNoteOn())
+    OscillatorBank::Controls controls;
+    controls.vco1PitchMult = vco1PitchBuffer.data();
+    controls.vco2PitchMult = vco2PitchBuffer.data();
+    controls.vco1Wave = vco1WaveBuffer.data();
+    controls.vco2Wave = vco2WaveBuffer.data();
+    controls.fmAmount = fmAmountBuffer.data();
+    controls.vco1Level = vco1LevelBuffer.data();
+    controls.vco2Level = vco2LevelBuffer.data();
+    controls.noise = noiseMixBuffer.data();  // generated at the host rate and held
+    controls.subLevel = subLevel;
+    controls.hardSync = hardSync;
+    oscillators.process(controls, numSamples, factor, input);
+
+    if (oversampled)
+    {
+        for (int i = 0; i < numSamples; ++i)
         {
-            lastMidiNote = message.getNoteNumber();
-            midiNoteActive = true;
-            // Convert MIDI note to pitch offset from C2 (MIDI note 36)
-            // C2 = 36, so offset = noteNumber - 36
-            midiNotePitch = static_cast<float>(lastMidiNote - 36);
+            std::fill_n(oversampledCutoffBuffer.data() + i * factor, factor, filterCutoffBuffer[i]);
+            std::fill_n(oversampledResBuffer.data() + i * factor, factor, filterResBuffer[i]);
         }
-        else if (message.isNoteOff())
+    }
+
+    filter.processBlock(input, cutoff, resonance, output, numSamples * factor);
+
+    // Back down a halving at a time, in place until the last
+    for (int stage = 0; stage < oversamplingOrder; ++stage)
+    {
+        const float* stageInput[] = { oversampledBuffer.data() };
+        float* stageOutput[] = { stage == oversamplingOrder - 1 ? filterOutputBuffer.data() : oversampledBuffer.data() };
+        decimators[static_cast<size_t>(stage)].downsample(stageInput, stageOutput, (numSamples * factor) >> (stage + 1));
+    }
+
+    // Fade out towards a pending oversampling change, or back in after one
+    const bool fadingOut = pendingOversamplingOrder != oversamplingOrder;
+    if (fadingOut || oversamplingFadeGain < 1.0f)
+    {
+        const float step = fadingOut ? -oversamplingFadeStep : oversamplingFadeStep;
+        float* samples = filterOutputBuffer.data();
+        for (int i = 0; i < numSamples; ++i)
         {
-            // When MIDI hold is active, ignore note-offs
-            bool holdActive = midiHoldParam->load() > 0.5f;
-            if (!holdActive && message.getNoteNumber() == lastMidiNote)
-            {
-                midiNoteActive = false;
-            }
+            oversamplingFadeGain = std::clamp(oversamplingFadeGain + step, 0.0f, 1.0f);
+            samples[i] *= oversamplingFadeGain;
         }
     }
+}
 
-    // Read all parameters
-    float vcoDecay = vcoDecayParam->load();
-    int seqPitchMod = static_cast<int>(seqPitchModParam->load());  // 0=VCO1&2, 1=OFF, 2=VCO2
-    float vco1EgAmt = vco1EgAmtParam->load();
-    float vco1Freq = vco1FreqParam->load();
-    float vco1Wave = vco1WaveParam->load();
-    float vco1Level = vco1LevelParam->load();
-    float subLevel = subLevelParam->load();
-    float noiseLevel = noiseLevelParam->load();
-
-    float fmAmount = fmAmountParam->load();
-    bool hardSync = hardSyncParam->load() > 0.5f;
-    float vco2EgAmt = vco2EgAmtParam->load();
-    float vco2Freq = vco2FreqParam->load();
-    float vco2Wave = vco2WaveParam->load();
-    float vco2Level = vco2LevelParam->load();
-
-    float filterCutoff = filterCutoffParam->load();
-    bool filterModeHP = filterModeParam->load() > 0.5f;
-    float filterRes = filterResParam->load();
-    bool vcaEgSlow = vcaEgModeParam->load() > 0.5f;
-    float vcaLevel = vcaLevelParam->load();
-
-    float filterDecay = filterDecayParam->load();
-    float filterEnvAmt = filterEnvAmtParam->load();
-    float noiseVcfMod = noiseVcfModParam->load();
-    float vcaDecay = vcaDecayParam->load();
-
-    float tempo = tempoParam->load();
-    int tempoMultIdx = static_cast<int>(tempoMultParam->load());
-    const float tempoMultipliers[] = { 0.25f, 0.5f, 1.0f, 2.0f, 4.0f };
-    float swing = swingParam->load();
-    int seqDirection = static_cast<int>(seqDirectionParam->load());
-    bool seqRun = seqRunParam->load() > 0.5f;
-    bool hostSync = hostSyncParam->load() > 0.5f;
+void DFAMSynthAudioProcessor::handleMidiMessage(const juce::MidiMessage& message)
+{
+    if (message.isNoteOn())
+    {
+        lastMidiNote = message.getNoteNumber();
+        midiNoteActive = true;
+        // Convert MIDI note to pitch offset from C2 (MIDI note 36)
+        // C2 = 36, so offset = noteNumber - 36
+        midiNotePitch = static_cast<float>(lastMidiNote - 36);
+    }
+    else if (message.isNoteOff())
+    {
+        // When MIDI hold is active, ignore note-offs
+        bool holdActive = parameters.getSnapshot().getBool(Param::midiHold);
+        if (!holdActive && message.getNoteNumber() == lastMidiNote)
+        {
+            midiNoteActive = false;
+        }
+    }
+}
 
-    // Host sync - override tempo and transport with DAW values
-    if (hostSync)
+void DFAMSynthAudioProcessor::updateOscillatorFrequencies()
+{
+    // Convert semitone pitch to Hz (C2 = 65.41 Hz as base)
+    const float c2Hz = 65.41f;
+    // Add MIDI pitch offset to VCO frequencies (when MIDI note is active)
+    float midiPitchOffset = midiNoteActive ? midiNotePitch : 0.0f;
+    float vco1FreqHz = c2Hz * std::pow(2.0f, (settings.vco1Freq + midiPitchOffset) / 12.0f);
+    float vco2FreqHz = c2Hz * std::pow(2.0f, (settings.vco2Freq + midiPitchOffset) / 12.0f);
+
+    oscillators.setFrequencies(vco1FreqHz, vco2FreqHz);  // the sub follows VCO1 an octave down
+}
+
+float DFAMSynthAudioProcessor::advanceRandomModValue(int numSamples)
+{
+    // Random value for random mod source (~50Hz update)
+    const int updateInterval = static_cast<int>(currentSampleRate / 50.0);
+
+    for (int i = 0; i < numSamples; ++i)
     {
-        if (auto* playHead = getPlayHead())
+        if (++randomModCounter > updateInterval)
         {
-            if (auto posInfo = playHead->getPosition())
+            randomModValue = modRandom.nextBipolar();
+            randomModCounter = 0;
+        }
+    }
+
+    return randomModValue;
+}
+
+void DFAMSynthAudioProcessor::setRandomSeed(uint32_t seed)
+{
+    randomSeed.store(seed);
+    apvts.state.setProperty("randomSeed", static_cast<int>(seed), nullptr);
+}
+
+void DFAMSynthAudioProcessor::restoreRandomSeed()
+{
+    if (apvts.state.hasProperty("randomSeed"))
+        randomSeed.store(static_cast<uint32_t>(static_cast<int>(apvts.state.getProperty("randomSeed"))));
+    else
+        setRandomSeed(randomSeed.load());
+}
+
+bool DFAMSynthAudioProcessor::loadReverbImpulse(const juce::File& file)
+{
+    if (!convolutionReverb.loadImpulseResponse(file))
+        return false;
+
+    apvts.state.setProperty("reverbImpulse", file.getFullPathName(), nullptr);
+    return true;
+}
+
+juce::File DFAMSynthAudioProcessor::getReverbImpulse() const
+{
+    const juce::String path = apvts.state.getProperty("reverbImpulse");
+    return juce::File::isAbsolutePath(path) ? juce::File(path) : juce::File();
+}
+
+void DFAMSynthAudioProcessor::restoreReverbImpulse()
+{
+    const auto file = getReverbImpulse();
+    if (file == juce::File() || !convolutionReverb.loadImpulseResponse(file))
+        convolutionReverb.clearImpulseResponse();
+}
+
+void DFAMSynthAudioProcessor::applyRandomSeed(uint32_t seed)
+{
+    appliedRandomSeed = seed;
+    noise.setSeed(seed, NoiseStream);
+    lfoRandom.setSeed(seed, LfoStream);
+    modRandom.setSeed(seed, ModStream);
+
+    lfoHoldValue = 0.0f;
+    lfoLastPhase = 0.0f;
+    randomModValue = 0.0f;
+    randomModCounter = 0;
+}
+
+void DFAMSynthAudioProcessor::evaluateModMatrix(int sample, int numSamples, ModMatrix::Values& values)
+{
+    // Sources, sampled at this point. The LFO and random generator then move on by
+    // numSamples, the span this evaluation stands for.
+    ModMatrix::Sources sources = {};
+
+    if (modMatrix.usesSource(ModMatrix::Lfo))
+        sources[ModMatrix::Lfo] = generateLFO(static_cast<float>(settings.lfoWave));
+    lfoPhase += settings.lfoPhaseInc * numSamples;
+    while (lfoPhase >= 1.0)
+        lfoPhase -= 1.0;
+
+    sources[ModMatrix::Random] = advanceRandomModValue(numSamples);
+
+    // Envelopes and velocity are 0-1, mapped to -1 to +1
+    sources[ModMatrix::PitchEnv] = pitchEnvBuffer[sample] * 2.0f - 1.0f;
+    sources[ModMatrix::FilterEnv] = filterEnvBuffer[sample] * 2.0f - 1.0f;
+    sources[ModMatrix::VcaEnv] = vcaEnvBuffer[sample] * 2.0f - 1.0f;
+    sources[ModMatrix::Velocity] = sequencer.getCurrentVelocity() * 2.0f - 1.0f;
+
+    modMatrix.process(sources, values);
+}
+
+void DFAMSynthAudioProcessor::renderModSources(int numSamples)
+{
+    // Envelopes and velocity are 0-1, mapped to -1 to +1
+    auto mapEnvelope = [numSamples](const float* env, float* out)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            out[i] = env[i] * 2.0f - 1.0f;
+    };
+
+    if (modMatrix.usesSource(ModMatrix::PitchEnv))
+        mapEnvelope(pitchEnvBuffer.data(), modSourceBuffers[ModMatrix::PitchEnv].data());
+    if (modMatrix.usesSource(ModMatrix::FilterEnv))
+        mapEnvelope(filterEnvBuffer.data(), modSourceBuffers[ModMatrix::FilterEnv].data());
+    if (modMatrix.usesSource(ModMatrix::VcaEnv))
+        mapEnvelope(vcaEnvBuffer.data(), modSourceBuffers[ModMatrix::VcaEnv].data());
+
+    // Velocity only changes on step boundaries, which never fall inside a sub-block
+    if (modMatrix.usesSource(ModMatrix::Velocity))
+        std::fill_n(modSourceBuffers[ModMatrix::Velocity].begin(), numSamples,
+                    sequencer.getCurrentVelocity() * 2.0f - 1.0f);
+
+    // The LFO and random generator run whether or not they are routed. The sine comes from
+    // the phasor oscillator, the other waves per sample.
+    const bool lfoUsed = modMatrix.usesSource(ModMatrix::Lfo);
+    const bool lfoSineUsed = lfoUsed && settings.lfoWave == 0;
+    if (lfoSineUsed)
+    {
+        lfoSine.reset(lfoPhase);
+        lfoSine.render(modSourceBuffers[ModMatrix::Lfo].data(), settings.lfoPhaseInc, numSamples);
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        if (lfoUsed && !lfoSineUsed)
+            modSourceBuffers[ModMatrix::Lfo][static_cast<size_t>(i)] = generateLFO(static_cast<float>(settings.lfoWave));
+        lfoPhase += settings.lfoPhaseInc;
+        if (lfoPhase >= 1.0)
+            lfoPhase -= 1.0;
+
+        modSourceBuffers[ModMatrix::Random][static_cast<size_t>(i)] = advanceRandomModValue(1);
+    }
+}
+
+void DFAMSynthAudioProcessor::renderModulation(int numSamples)
+{
+    if (settings.modInterval <= 1)
+    {
+        // Audio rate: render each source that is routed anywhere, then run the
+        // route table over the whole sub-block
+        renderModSources(numSamples);
+
+        std::array<const float*, ModMatrix::NUM_SOURCES> sources;
+        for (size_t src = 0; src < sources.size(); ++src)
+            sources[src] = modSourceBuffers[src].data();
+
+        std::array<float*, ModMatrix::NUM_DESTINATIONS> destinations;
+        for (size_t d = 0; d < destinations.size(); ++d)
+            destinations[d] = modBuffers[d].data();
+
+        modMatrix.processBlock(sources.data(), destinations.data(), numSamples);
+
+        // Hand the last values to the ramps in case the rate switches to control rate
+        for (size_t d = 0; d < destinations.size(); ++d)
+            modRampValues[d] = modBuffers[d][static_cast<size_t>(numSamples - 1)];
+        modRampTargets = modRampValues;
+        modRampIncrements.fill(0.0f);
+        modSamplesUntilUpdate = 0;
+        return;
+    }
+
+    // Control rate: evaluate at the start of each interval and ramp linearly from the
+    // current value to the evaluation across it, so the destinations trail the sources by
+    // the interval. An interval cut short (by a step trigger) leaves the ramp part way, and
+    // the next one carries on from there. The interval carries across sub-blocks.
+    int i = 0;
+    while (i < numSamples)
+    {
+        if (modSamplesUntilUpdate == 0)
+        {
+            const int interval = settings.modInterval;
+            evaluateModMatrix(i, interval, modRampTargets);
+
+            const float invInterval = 1.0f / static_cast<float>(interval);
+            for (int d = 0; d < ModMatrix::NUM_DESTINATIONS; ++d)
+                modRampIncrements[d] = (modRampTargets[d] - modRampValues[d]) * invInterval;
+
+            modSamplesUntilUpdate = interval;
+        }
+
+        const int runLength = std::min(modSamplesUntilUpdate, numSamples - i);
+        for (int d = 0; d < ModMatrix::NUM_DESTINATIONS; ++d)
+        {
+            float value = modRampValues[d];
+            const float increment = modRampIncrements[d];
+            float* out = modBuffers[d].data() + i;
+            for (int k = 0; k < runLength; ++k)
             {
-                // Sync tempo to host
-                if (posInfo->getBpm().hasValue())
-                    tempo = static_cast<float>(*posInfo->getBpm());
-
-                // Sync transport to host (play/stop)
-                if (posInfo->getIsPlaying())
-                    seqRun = true;
-                else
-                    seqRun = false;
+                value += increment;
+                out[k] = value;
             }
+            modRampValues[d] = value;
         }
+
+        i += runLength;
+        modSamplesUntilUpdate -= runLength;
+    }
+}
+
+void DFAMSynthAudioProcessor::updateBlockSettings()
+{
+    const auto& params = parameters.getSnapshot();
+
+    float vcoDecay = params[Param::vcoDecay];
+    settings.seqPitchMod = params.getInt(Param::seqPitchMod);  // 0=VCO1&2, 1=OFF, 2=VCO2
+    settings.vco1EgAmt = params[Param::vco1EgAmt];
+    settings.vco1Freq = params[Param::vco1Freq];
+    settings.vco1Wave = params[Param::vco1Wave];
+    settings.vco1Level = params[Param::vco1Level];
+    settings.subLevel = params[Param::subLevel];
+    settings.noiseLevel = params[Param::noiseLevel];
+
+    settings.fmAmount = params[Param::fmAmount];
+    settings.hardSync = params.getBool(Param::hardSync);
+    bool vcoAntiAlias = params.getBool(Param::vcoAntiAlias);
+    bool vcoWavetable = params.getBool(Param::vcoWavetable);
+
+    settings.vco2EgAmt = params[Param::vco2EgAmt];
+    settings.vco2Freq = params[Param::vco2Freq];
+    settings.vco2Wave = params[Param::vco2Wave];
+    settings.vco2Level = params[Param::vco2Level];
+
+    settings.filterCutoff = params[Param::filterCutoff];
+    bool filterModeHP = params.getBool(Param::filterMode);
+    settings.filterRes = params[Param::filterRes];
+    bool vcaEgSlow = params.getBool(Param::vcaEgMode);
+    settings.vcaLevel = params[Param::vcaLevel];
+
+    float filterDecay = params[Param::filterDecay];
+    settings.filterEnvAmt = params[Param::filterEnvAmt];
+    settings.noiseVcfMod = params[Param::noiseVcfMod];
+    float vcaDecay = params[Param::vcaDecay];
+
+    float tempo = params[Param::tempo];
+    int tempoMultIdx = params.getInt(Param::tempoMult);
+    const float tempoMultipliers[] = { 0.25f, 0.5f, 1.0f, 2.0f, 4.0f };
+    float swing = params[Param::swing];
+    int seqDirection = params.getInt(Param::seqDirection);
+    bool seqRun = params.getBool(Param::seqRun);
+    bool hostSync = params.getBool(Param::hostSync);
+
+    // Host sync - override tempo and transport with DAW values
+    if (hostSync && hostTransport.valid)
+    {
+        // Sync tempo to host
+        if (hostTransport.hasBpm)
+            tempo = hostTransport.bpm;
+
+        // Sync transport to host (play/stop)
+        seqRun = hostTransport.isPlaying;
     }
 
     // Apply tempo multiplier AFTER host sync so it works in both modes
     tempo *= tempoMultipliers[tempoMultIdx];
 
     // Ring modulator parameters
-    float ringModFreq = ringModFreqParam->load();
-    float ringModMix = ringModMixParam->load();
-    ringModPhaseInc = ringModFreq / currentSampleRate;
-
-    // Delay parameters
-    float delayTimeSeconds = delayTimeParam->load();
-    float delayFeedback = delayFeedbackParam->load();
-    float delayFilterCutoff = delayFilterParam->load();
-    float delayMix = delayMixParam->load();
-
-    // Reverb parameters
-    float reverbDecay = reverbDecayParam->load();
-    float reverbFilterCutoff = reverbFilterParam->load();
-    float reverbMix = reverbMixParam->load();
+    const float ringModMix = params[Param::ringModMix];
+    ringMod.setFrequency(params[Param::ringModFreq]);
+    ringMod.setMix(ringModMix);
+    fxStages[RingModStage].setEnabled(ringModMix > 0.0f);
+
+    // Delay parameters. The resonator only recomputes its step delays when the delay time,
+    // loss filter or step pitches (below) actually change.
+    float delayFilterCutoff = params[Param::delayFilter];
+    const float delayMix = params[Param::delayMix];
+    resonator.setDelayTime(params[Param::delayTime]);
+    resonator.setFeedback(params[Param::delayFeedback]);
+    resonator.setMix(delayMix);
+    resonator.setMultiString(params.getBool(Param::delayMultiString));
+    fxStages[ResonatorStage].setEnabled(delayMix > 0.0f);
+
+    // Reverb parameters. Convolution needs an impulse response; the network runs until one
+    // is loaded and the convolution has taken it up.
+    const float reverbMix = params[Param::reverbMix];
+    if (!useConvolutionReverb)
+        convolutionReverb.pollImpulseResponse();
+    const bool convolution = params.getInt(Param::reverbType) == 1 && convolutionReverb.hasImpulseResponse();
+    if (convolution != useConvolutionReverb)
+    {
+        useConvolutionReverb = convolution;
+        if (useConvolutionReverb)
+            convolutionReverb.reset();
+        else
+            reverb.reset();
+        reverbCrossfadeRemaining = reverbCrossfadeLength;
+    }
 
-    // Calculate reverb filter coefficient
-    float reverbFilterCoeff = std::exp(-2.0f * juce::MathConstants<float>::pi * reverbFilterCutoff / static_cast<float>(currentSampleRate));
+    updateReverbDecimation(params[Param::reverbFilter]);
+    reverb.setQuality(static_cast<StereoReverb::Quality>(std::clamp(params.getInt(Param::reverbQuality), 0, 2)));
+    reverb.setDecay(params[Param::reverbDecay]);
+    reverb.setFilterCutoff(params[Param::reverbFilter]);
+    reverb.setMix(reverbMix);
+    convolutionReverb.setFilterCutoff(params[Param::reverbFilter]);
+    convolutionReverb.setMix(reverbMix);
+    fxStages[ReverbStage].setEnabled(reverbMix > 0.0f);
+    fxStages[ReverbStage].setTailHold(useConvolutionReverb ? convolutionReverb.getTailHoldSamples()
+                                                           : reverb.getTailHoldSamples());
 
     // Scale quantization parameters
-    int scaleType = static_cast<int>(scaleTypeParam->load());
-    int scaleRoot = static_cast<int>(scaleRootParam->load());
+    int scaleType = params.getInt(Param::scaleType);
+    int scaleRoot = params.getInt(Param::scaleRoot);
 
     // Mod matrix parameters
-    float lfoRate = lfoRateParam->load();
-    int lfoWave = static_cast<int>(lfoWaveParam->load());
-    bool lfoSync = lfoSyncParam->load() > 0.5f;
+    float lfoRate = params[Param::lfoRate];
+    settings.lfoWave = params.getInt(Param::lfoWave);
+    const int modRateIntervals[] = { 1, 16, 32, 64 };
+    settings.modInterval = modRateIntervals[std::clamp(params.getInt(Param::modRate), 0, 3)];
+    bool lfoSync = params.getBool(Param::lfoSync);
 
     // If tempo-synced, convert rate to divisions of tempo
     // Rate 1.0 = 1 bar, 2.0 = 1/2 note, 4.0 = 1/4 note, etc.
-    double lfoPhaseInc;
     if (lfoSync)
     {
         // Sync rate: map 0.1-20 to tempo divisions
         // We'll make rate represent "cycles per beat"
         float beatsPerSecond = tempo / 60.0f;
-        lfoPhaseInc = (lfoRate * beatsPerSecond) / currentSampleRate;
+        settings.lfoPhaseInc = (lfoRate * beatsPerSecond) / currentSampleRate;
     }
     else
     {
-        lfoPhaseInc = lfoRate / currentSampleRate;
+        settings.lfoPhaseInc = lfoRate / currentSampleRate;
     }
 
-    // Read mod slot parameters
-    std::array<int, NUM_MOD_SLOTS> modSrc, modDst;
-    std::array<float, NUM_MOD_SLOTS> modAmt;
-    for (int i = 0; i < NUM_MOD_SLOTS; ++i)
+    // Read mod slot parameters; the matrix only recompiles its routing if a slot changed
+    static_assert(ModMatrix::NUM_SLOTS == Param::NUM_MOD_SLOTS, "Mod slot count mismatch");
+    std::array<ModMatrix::Slot, ModMatrix::NUM_SLOTS> modSlots;
+    for (int i = 0; i < ModMatrix::NUM_SLOTS; ++i)
     {
-        modSrc[i] = static_cast<int>(modSrcParams[i]->load());
-        modDst[i] = static_cast<int>(modDstParams[i]->load());
-        modAmt[i] = modAmtParams[i]->load();
+        modSlots[static_cast<size_t>(i)].source = params.getInt(Param::modSrc1 + i);
+        modSlots[static_cast<size_t>(i)].destination = params.getInt(Param::modDst1 + i);
+        modSlots[static_cast<size_t>(i)].amount = params[Param::modAmt1 + i];
     }
-
-    // Base delay time from slider (will be combined with sequencer pitch in the loop)
+    modMatrix.setSlots(modSlots);
 
     // Calculate lowpass filter coefficient for delay feedback
-    float delayFilterCoeff = std::exp(-2.0f * juce::MathConstants<float>::pi * delayFilterCutoff / static_cast<float>(currentSampleRate));
+    resonator.setLossFilter(std::exp(-2.0f * juce::MathConstants<float>::pi * delayFilterCutoff / static_cast<float>(currentSampleRate)));
+
+    // Drone mode waveform smoothing (one-pole, ~5 rad/s)
+    settings.waveSmooth = 1.0f - std::exp(-5.0f / static_cast<float>(currentSampleRate));
+
+    // Glide (portamento): glide 0 = instant, glide 1 = very slow (drone-like)
+    settings.glideAmount = params[Param::glide];
+    settings.drone = params.getBool(Param::drone);
+
+    // In drone mode, force very slow crossfade glide
+    if (settings.drone)
+        settings.glideAmount = std::max(settings.glideAmount, 0.85f);  // Minimum 85% glide in drone mode
+
+    // Higher glide value = slower transition
+    // Map glide 0-1 to time constant (fast to very slow)
+    float glideSpeed = 1.0f - settings.glideAmount;  // 1 = fast, 0 = frozen
+    glideSpeed = glideSpeed * glideSpeed;  // Quadratic curve - less aggressive at low values
 
-    // Update reverb parameters
-    // Improved reverb settings for warmer sound
-    reverbParams.roomSize = 0.2f + reverbDecay * 0.5f;  // 0.2 to 0.7 range (less extreme)
-    reverbParams.damping = 0.7f + reverbDecay * 0.25f;  // 0.7 to 0.95 - warmer, less metallic
-    reverbParams.wetLevel = 1.0f;
-    reverbParams.dryLevel = 0.0f;
-    reverbParams.width = 0.6f + reverbDecay * 0.3f;     // Tighter stereo image
-    reverb.setParameters(reverbParams);
+    // In drone mode, make transitions even smoother
+    const float glideBaseSpeed = settings.drone ? 5.0f : 20.0f;
+    settings.glideCoeff = 1.0f - std::exp(-glideSpeed * glideBaseSpeed / static_cast<float>(currentSampleRate));
 
     // Update sequencer step parameters (with scale quantization)
+    std::array<float, KarplusStrong::NUM_STEPS> delayPitches;
     for (int i = 0; i < 8; ++i)
     {
-        float rawPitch = seqPitchParams[i]->load();
+        float rawPitch = params[Param::seqPitch1 + i];
         float quantizedPitch = quantizePitchToScale(rawPitch, scaleType, scaleRoot);
         sequencer.setStepPitch(i, quantizedPitch);
-        sequencer.setStepVelocity(i, seqVelParams[i]->load());
-        sequencer.setStepPan(i, seqPanParams[i]->load());
-        sequencer.setStepWave(i, seqWaveParams[i]->load());
-        sequencer.setStepRingMod(i, seqRingModParams[i]->load());
+        sequencer.setStepVelocity(i, params[Param::seqVel1 + i]);
+        sequencer.setStepPan(i, params[Param::seqPan1 + i]);
+        sequencer.setStepWave(i, params[Param::seqWave1 + i]);
+        sequencer.setStepRingMod(i, params[Param::seqRingMod1 + i]);
         // Also quantize delay pitch to scale
-        float rawDelayPitch = seqDelayPitchParams[i]->load();
+        float rawDelayPitch = params[Param::seqDelayPitch1 + i];
         float quantizedDelayPitch = quantizePitchToScale(rawDelayPitch, scaleType, scaleRoot);
         sequencer.setStepDelayPitch(i, quantizedDelayPitch);
+        delayPitches[static_cast<size_t>(i)] = sequencer.getStepDelayPitch(i);
     }
-
-    // Convert semitone pitch to Hz (C2 = 65.41 Hz as base)
-    const float c2Hz = 65.41f;
-    // Add MIDI pitch offset to VCO frequencies (when MIDI note is active)
-    float midiPitchOffset = midiNoteActive ? midiNotePitch : 0.0f;
-    float vco1FreqHz = c2Hz * std::pow(2.0f, (vco1Freq + midiPitchOffset) / 12.0f);
-    float vco2FreqHz = c2Hz * std::pow(2.0f, (vco2Freq + midiPitchOffset) / 12.0f);
-
-    // Set up oscillators (waveform set per-step in the loop)
-    vco1.setFrequency(vco1FreqHz);
-    vco1.setWaveformPosition(vco1Wave);  // default, will be overridden per-step
-    vco2.setFrequency(vco2FreqHz);
-    vco2.setWaveformPosition(vco2Wave);  // default, will be overridden per-step
-    subOsc.setFrequency(vco1FreqHz * 0.5f);  // 1 octave below VCO1
-    subOsc.setWaveformPosition(0.66f);       // Fixed square wave
+    resonator.setStepPitches(delayPitches);
+    fxStages[ResonatorStage].setTailHold(resonator.getLongestDelay());
+
+    // Reported to the host as the tail: the longest hold of the enabled stages (the
+    // convolution reverb's is its impulse response limit, MAX_IR_SECONDS)
+    int longestTailHold = 0;
+    for (const auto& stage : fxStages)
+        if (stage.isEnabled())
+            longestTailHold = std::max(longestTailHold, stage.getTailHold());
+    tailLengthSeconds.store(longestTailHold / currentSampleRate, std::memory_order_relaxed);
+
+    // Set up oscillators (waveform set per-step in the loop, frequency again at MIDI events)
+    updateOscillatorFrequencies();
+    oscillators.setBandLimited(vcoAntiAlias);
+    oscillators.setWavetableEnabled(vcoWavetable);
 
     // Set up filter
-    filter.setResonance(filterRes);
     filter.setMode(filterModeHP ? LadderFilter::Mode::Highpass : LadderFilter::Mode::Lowpass);
 
     // Set up envelopes
@@ -733,140 +1062,82 @@ void DFAMSynthAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     sequencer.setDirection(seqDirection);
     sequencer.setRunning(seqRun);
 
-    // Check for manual trigger/advance
-    bool doManualTrigger = manualTrigger.exchange(false);
-    bool doManualAdvance = manualAdvance.exchange(false);
-
-    // Process audio
-    auto* leftChannel = buffer.getWritePointer(0);
-    auto* rightChannel = totalNumOutputChannels > 1 ? buffer.getWritePointer(1) : nullptr;
-
-    for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
-    {
-        // Process sequencer
-        bool stepTrigger = sequencer.process();
-
-        // Handle manual advance (only on first sample of block)
-        if (sample == 0 && doManualAdvance)
-        {
-            sequencer.advanceStep();
-            stepTrigger = true;
-        }
-
-        // Handle manual trigger
-        if (sample == 0 && doManualTrigger)
-        {
-            stepTrigger = true;
-        }
-
-        if (stepTrigger)
-        {
-            // In drone mode, don't retrigger envelopes - sound continues smoothly
-            bool droneMode = droneParam->load() > 0.5f;
-            if (!droneMode)
-            {
-                // Trigger all envelopes
-                float velocity = sequencer.getCurrentVelocity();
-                pitchEnv.trigger(velocity);
-                filterEnv.trigger(velocity);
-                vcaEnv.trigger(velocity);
-            }
-        }
-
-        // Get envelope values
-        float pitchEnvValue = pitchEnv.process();
-        float filterEnvValue = filterEnv.process();
-        float vcaEnvValue = vcaEnv.process();
-
-        // Generate LFO value
-        float lfoValue = generateLFO(static_cast<float>(lfoWave));
-        lfoPhase += lfoPhaseInc;
-        if (lfoPhase >= 1.0)
-            lfoPhase -= 1.0;
-
-        // Process mod matrix - initialize modulation accumulators
-        float filterCutoffMod = 0.0f;
-        float filterResMod = 0.0f;
-        float vco1PitchModMatrix = 0.0f;
-        float vco2PitchModMatrix = 0.0f;
-        float ringFreqMod = 0.0f;
-        float panMod = 0.0f;
-        float vco1LevelMod = 0.0f;
-        float vco2LevelMod = 0.0f;
-        float vcaDecayMod = 0.0f;
-        float noiseVcfModMod = 0.0f;
-        float vcfDecayMod = 0.0f;
-        float fmAmountMod = 0.0f;
-
-        // Current velocity from sequencer (for velocity mod source)
-        float currentVelocity = sequencer.getCurrentVelocity();
-
-        // Random value for random mod source (regenerated per-sample for variation)
-        static float randomModValue = 0.0f;
-        static int randomCounter = 0;
-        if (++randomCounter > static_cast<int>(currentSampleRate / 50.0))  // ~50Hz update
-        {
-            randomModValue = (static_cast<float>(rand()) / RAND_MAX) * 2.0f - 1.0f;
-            randomCounter = 0;
-        }
+}
 
-        for (int slot = 0; slot < NUM_MOD_SLOTS; ++slot)
-        {
-            if (modSrc[slot] == 0 || modDst[slot] == 0)
-                continue;  // Skip if source or dest is OFF
+int DFAMSynthAudioProcessor::getVoiceFeatures(bool stereo) const
+{
+    int features = 0;
+    if (settings.seqPitchMod == 0 || settings.seqPitchMod == 2)  // VCO 1&2 or VCO 2 only
+        features |= SeqPitchVco2Feature;
+    if (settings.seqPitchMod == 0)
+        features |= SeqPitchVco1Feature;
+    if (settings.drone)
+        features |= DroneFeature;
+    if (fxStages[RingModStage].isEnabled())
+        features |= RingModFeature;
+    if (stereo)
+        features |= StereoFeature;
+    return features;
+}
 
-            // Get modulation source value (-1 to +1)
-            float srcValue = 0.0f;
-            switch (modSrc[slot])
-            {
-                case 1: srcValue = lfoValue; break;           // LFO
-                case 2: srcValue = pitchEnvValue * 2.0f - 1.0f; break;  // Pitch Env (0-1 -> -1 to +1)
-                case 3: srcValue = filterEnvValue * 2.0f - 1.0f; break; // Filter Env
-                case 4: srcValue = vcaEnvValue * 2.0f - 1.0f; break;    // VCA Env
-                case 5: srcValue = currentVelocity * 2.0f - 1.0f; break; // Velocity
-                case 6: srcValue = randomModValue; break;      // Random
-            }
+// One kernel per feature mask, so each renderVoice<features> is compiled without the
+// branches for features it doesn't have
+template <size_t... masks>
+std::array<DFAMSynthAudioProcessor::VoiceKernel, sizeof...(masks)>
+    DFAMSynthAudioProcessor::makeVoiceKernels(std::index_sequence<masks...>)
+{
+    return { &DFAMSynthAudioProcessor::renderVoice<static_cast<int>(masks)>... };
+}
 
-            // Apply amount
-            float modValue = srcValue * modAmt[slot];
+const std::array<DFAMSynthAudioProcessor::VoiceKernel, DFAMSynthAudioProcessor::NUM_VOICE_KERNELS>
+    DFAMSynthAudioProcessor::voiceKernels = makeVoiceKernels(std::make_index_sequence<NUM_VOICE_KERNELS>());
 
-            // Route to destination
-            switch (modDst[slot])
-            {
-                case 1: filterCutoffMod += modValue; break;    // Filter Cutoff
-                case 2: filterResMod += modValue; break;       // Filter Resonance
-                case 3: vco1PitchModMatrix += modValue * 12.0f; break;  // VCO1 Pitch (±12 semitones)
-                case 4: vco2PitchModMatrix += modValue * 12.0f; break;  // VCO2 Pitch
-                case 5: ringFreqMod += modValue; break;        // Ring Freq
-                case 6: panMod += modValue; break;             // Pan
-                case 7: vco1LevelMod += modValue * 0.5f; break; // VCO1 Level
-                case 8: vco2LevelMod += modValue * 0.5f; break; // VCO2 Level
-                case 9: vcaDecayMod += modValue; break;        // VCA Decay
-                case 10: noiseVcfModMod += modValue; break;    // Noise VCF Mod
-                case 11: vcfDecayMod += modValue; break;       // VCF Decay
-                case 12: fmAmountMod += modValue * 0.5f; break; // FM Amount
-            }
-        }
+template <int features>
+void DFAMSynthAudioProcessor::renderVoice(int blockStart, int blockSize, bool vcaActive,
+                                          float* leftChannel, float* rightChannel)
+{
+    // The step can't change within a sub-block, so its values are read once
+    if constexpr ((features & (SeqPitchVco1Feature | SeqPitchVco2Feature)) != 0)
+        targetGlidePitch = sequencer.getCurrentPitch();
+
+    // Combine VCO wave knobs with sequencer wave modulation
+    // Sequencer wave (0-1) adds modulation to the base wave position
+    const float seqWaveMod = (sequencer.getCurrentWave() - 0.5f) * 0.5f;  // -0.25 to +0.25 modulation
+    const float vco1WaveTarget = std::clamp(settings.vco1Wave + seqWaveMod, 0.0f, 1.0f);
+    const float vco2WaveTarget = std::clamp(settings.vco2Wave + seqWaveMod, 0.0f, 1.0f);
+
+    // Sequencer modulates ring mod frequency (0-1 maps to 0.25x to 4x base freq)
+    const float seqRingFreqMult = 0.25f + sequencer.getCurrentRingMod() * 3.75f;
+    const float seqPan = sequencer.getCurrentPan();
+
+    // Pass 1: oscillator and filter controls are gathered per sample so the
+    // oscillator -> filter section can run as one block.
+    for (int i = 0; i < blockSize; ++i)
+    {
+        float pitchEnvValue = pitchEnvBuffer[i];
+        float filterEnvValue = filterEnvBuffer[i];
+        float vcaEnvValue = vcaEnvBuffer[i];
+
+        // Mod matrix outputs for this sample
+        float filterCutoffMod = modBuffers[ModMatrix::FilterCutoff][i];
+        float filterResMod = modBuffers[ModMatrix::FilterRes][i];
+        float vco1PitchModMatrix = modBuffers[ModMatrix::Vco1Pitch][i];
+        float vco2PitchModMatrix = modBuffers[ModMatrix::Vco2Pitch][i];
+        float ringFreqMod = modBuffers[ModMatrix::RingFreq][i];
+        float panMod = modBuffers[ModMatrix::Pan][i];
+        float vco1LevelMod = modBuffers[ModMatrix::Vco1Level][i];
+        float vco2LevelMod = modBuffers[ModMatrix::Vco2Level][i];
+        float vcaDecayMod = modBuffers[ModMatrix::VcaDecay][i];
+        float noiseVcfModMod = modBuffers[ModMatrix::NoiseVcfMod][i];
+        float vcfDecayMod = modBuffers[ModMatrix::VcfDecay][i];
+        float fmAmountMod = modBuffers[ModMatrix::FmAmount][i];
 
         // Calculate pitch modulation from sequencer with glide/portamento
         float seqPitchSemitones = 0.0f;
-        if (seqPitchMod != 1)  // Not OFF
+        if constexpr ((features & (SeqPitchVco1Feature | SeqPitchVco2Feature)) != 0)
         {
-            // Get target pitch from sequencer
-            targetGlidePitch = std::log2(sequencer.getCurrentPitchMultiplier()) * 12.0f;
-
             // Apply glide (portamento)
-            // glide 0 = instant, glide 1 = very slow (drone-like)
-            float glideAmount = glideParam->load();
-            bool droneMode = droneParam->load() > 0.5f;
-
-            // In drone mode, force very slow crossfade glide
-            if (droneMode)
-            {
-                glideAmount = std::max(glideAmount, 0.85f);  // Minimum 85% glide in drone mode
-            }
-
-            if (glideAmount < 0.01f)
+            if (settings.glideAmount < 0.01f)
             {
                 // No glide - instant pitch change
                 currentGlidePitch = targetGlidePitch;
@@ -874,16 +1145,7 @@ void DFAMSynthAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
             else
             {
                 // Glide: smoothly move toward target
-                // Higher glide value = slower transition
-                // Map glide 0-1 to time constant (fast to very slow)
-                float glideSpeed = 1.0f - glideAmount;  // 1 = fast, 0 = frozen
-                glideSpeed = glideSpeed * glideSpeed;  // Quadratic curve - less aggressive at low values
-
-                // In drone mode, make transitions even smoother
-                float baseSpeed = droneMode ? 5.0f : 20.0f;
-                float glideCoeff = 1.0f - std::exp(-glideSpeed * baseSpeed / static_cast<float>(currentSampleRate));
-
-                currentGlidePitch += (targetGlidePitch - currentGlidePitch) * glideCoeff;
+                currentGlidePitch += (targetGlidePitch - currentGlidePitch) * settings.glideCoeff;
             }
 
             seqPitchSemitones = currentGlidePitch;
@@ -891,80 +1153,48 @@ void DFAMSynthAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
 
         // Calculate pitch envelope modulation (in semitones, scaled by amount)
         // Add mod matrix pitch modulation
-        float vco1PitchMod = pitchEnvValue * vco1EgAmt * 24.0f + vco1PitchModMatrix;
-        float vco2PitchMod = pitchEnvValue * vco2EgAmt * 24.0f + vco2PitchModMatrix;
+        float vco1PitchMod = pitchEnvValue * settings.vco1EgAmt * 24.0f + vco1PitchModMatrix;
+        float vco2PitchMod = pitchEnvValue * settings.vco2EgAmt * 24.0f + vco2PitchModMatrix;
 
         // Add sequencer pitch to appropriate oscillators
-        if (seqPitchMod == 0)  // VCO 1&2
-        {
+        if constexpr ((features & SeqPitchVco1Feature) != 0)
             vco1PitchMod += seqPitchSemitones;
+        if constexpr ((features & SeqPitchVco2Feature) != 0)
             vco2PitchMod += seqPitchSemitones;
-        }
-        else if (seqPitchMod == 2)  // VCO 2 only
-        {
-            vco2PitchMod += seqPitchSemitones;
-        }
-
-        // Combine VCO wave knobs with sequencer wave modulation
-        // Sequencer wave (0-1) adds modulation to the base wave position
-        float seqWaveMod = (sequencer.getCurrentWave() - 0.5f) * 0.5f;  // -0.25 to +0.25 modulation
-        float vco1WaveTarget = std::clamp(vco1Wave + seqWaveMod, 0.0f, 1.0f);
-        float vco2WaveTarget = std::clamp(vco2Wave + seqWaveMod, 0.0f, 1.0f);
 
         // In drone mode, smooth waveform transitions to avoid clicks
-        bool droneModeWave = droneParam->load() > 0.5f;
-        if (droneModeWave)
+        if constexpr ((features & DroneFeature) != 0)
         {
-            float waveSmooth = 1.0f - std::exp(-5.0f / static_cast<float>(currentSampleRate));
-            smoothedWave1 += (vco1WaveTarget - smoothedWave1) * waveSmooth;
-            smoothedWave2 += (vco2WaveTarget - smoothedWave2) * waveSmooth;
-            vco1.setWaveformPosition(smoothedWave1);
-            vco2.setWaveformPosition(smoothedWave2);
+            smoothedWave1 += (vco1WaveTarget - smoothedWave1) * settings.waveSmooth;
+            smoothedWave2 += (vco2WaveTarget - smoothedWave2) * settings.waveSmooth;
+            vco1WaveBuffer[i] = smoothedWave1;
+            vco2WaveBuffer[i] = smoothedWave2;
         }
         else
         {
-            vco1.setWaveformPosition(vco1WaveTarget);
-            vco2.setWaveformPosition(vco2WaveTarget);
-        }
-
-        // Generate VCO2 first (needed for FM and sync)
-        float vco2Sample = vco2.processWithPitchMod(vco2PitchMod);
-
-        // Hard sync: reset VCO1 phase when VCO2 completes a cycle
-        if (hardSync && vco2.hasCompletedCycle())
-        {
-            vco1.sync();
+            vco1WaveBuffer[i] = vco1WaveTarget;
+            vco2WaveBuffer[i] = vco2WaveTarget;
         }
 
-        // Generate VCO1 with FM from VCO2 and pitch modulation
+        // Oscillator controls (VCOs and sub run later at the oversampled rate).
+        // Pitch in octaves for now, converted to multipliers after this loop
+        vco1PitchBuffer[i] = vco1PitchMod * (1.0f / 12.0f);
+        vco2PitchBuffer[i] = vco2PitchMod * (1.0f / 12.0f);
         // Apply mod matrix to FM amount
-        float modulatedFmAmount = std::clamp(fmAmount + fmAmountMod, 0.0f, 1.0f);
-        float vco1PitchWithFM = vco1PitchMod + (vco2Sample * modulatedFmAmount * 24.0f);
-        float vco1Sample = vco1.processWithPitchMod(vco1PitchWithFM);
+        fmAmountBuffer[i] = std::clamp(settings.fmAmount + fmAmountMod, 0.0f, 1.0f);
 
-        // Generate sub oscillator (follows VCO1 pitch modulation, 1 octave below)
-        float subSample = 0.0f;
-        if (subLevel > 0.0f)
-        {
-            subSample = subOsc.processWithPitchMod(vco1PitchMod);
-        }
-
-        // Generate noise
-        float noiseSample = noise.process();
+        float noiseSample = noiseMixBuffer[i];
 
         // Apply mod matrix level modulation (clamped to 0-1)
-        float vco1LevelModulated = std::clamp(vco1Level + vco1LevelMod, 0.0f, 1.0f);
-        float vco2LevelModulated = std::clamp(vco2Level + vco2LevelMod, 0.0f, 1.0f);
-
-        // Mix all oscillators
-        float mixed = vco1Sample * vco1LevelModulated + vco2Sample * vco2LevelModulated + noiseSample * noiseLevel;
-        mixed += subSample * subLevel;
+        vco1LevelBuffer[i] = std::clamp(settings.vco1Level + vco1LevelMod, 0.0f, 1.0f);
+        vco2LevelBuffer[i] = std::clamp(settings.vco2Level + vco2LevelMod, 0.0f, 1.0f);
+        noiseMixBuffer[i] = noiseSample * settings.noiseLevel;
 
         // Calculate filter cutoff modulation
         // Apply mod matrix to noise VCF mod (noiseVcfModMod adds ±1 to the -1 to +1 range)
-        float modulatedNoiseVcfMod = std::clamp(noiseVcfMod + noiseVcfModMod, -1.0f, 1.0f);
+        float modulatedNoiseVcfMod = std::clamp(settings.noiseVcfMod + noiseVcfModMod, -1.0f, 1.0f);
         // Apply mod matrix to filter envelope amount (vcfDecayMod scales the env amount)
-        float modulatedFilterEnvAmt = std::clamp(filterEnvAmt + vcfDecayMod, -1.0f, 1.0f);
+        float modulatedFilterEnvAmt = std::clamp(settings.filterEnvAmt + vcfDecayMod, -1.0f, 1.0f);
         float cutoffMod = filterEnvValue * modulatedFilterEnvAmt * 10.0f;
         // Directional noise modulation: positive = brighten, negative = darken
         float noiseVcfValue = (modulatedNoiseVcfMod >= 0.0f)
@@ -973,125 +1203,316 @@ void DFAMSynthAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
         cutoffMod += noiseVcfValue;
         cutoffMod += filterCutoffMod * 5.0f;  // Mod matrix: ±5 octaves
 
-        float modulatedCutoff = filterCutoff * std::pow(2.0f, cutoffMod);
-        modulatedCutoff = std::clamp(modulatedCutoff, 20.0f, 20000.0f);
+        // Octaves for now, converted to Hz for the whole sub-block after this loop
+        filterCutoffBuffer[i] = cutoffMod;
 
         // Apply resonance modulation
-        float modulatedRes = std::clamp(filterRes + filterResMod * 0.5f, 0.0f, 1.0f);
-
-        filter.setCutoff(modulatedCutoff);
-        filter.setResonance(modulatedRes);
-        float filtered = filter.process(mixed);
+        float modulatedRes = std::clamp(settings.filterRes + filterResMod * 0.5f, 0.0f, 1.0f);
+        filterResBuffer[i] = modulatedRes;
 
         // Apply VCA envelope (in drone mode, keep VCA open)
         // VCA Decay mod affects the envelope curve (positive = longer sustain, negative = faster decay)
-        bool droneMode = droneParam->load() > 0.5f;
-        float modulatedVcaEnvValue = vcaEnvValue;
-        if (vcaDecayMod > 0.0f)
-            modulatedVcaEnvValue = std::pow(vcaEnvValue, 1.0f - vcaDecayMod * 0.8f);  // Slower decay
-        else if (vcaDecayMod < 0.0f)
-            modulatedVcaEnvValue = std::pow(vcaEnvValue, 1.0f - vcaDecayMod * 2.0f);  // Faster decay
-        float vcaValue = droneMode ? 1.0f : modulatedVcaEnvValue;
-        float output = filtered * vcaValue * vcaLevel;
-
-        // === FX ORDER: Delay (with filter) -> Ring Mod -> Reverb ===
-
-        // 1. Calculate Karplus-Strong tuned delay time from sequencer pitch
-        // Base frequency C2 = 65.41 Hz, pitch in semitones offsets this
-        float delayPitch = sequencer.getCurrentDelayPitch();
-        const float ksBaseFreq = 65.41f; // C2
-        float ksFreq = ksBaseFreq * std::pow(2.0f, delayPitch / 12.0f);
-        float ksDelayTimeSeconds = 1.0f / ksFreq;
-
-        // Combine Karplus-Strong pitch-based delay with base delay time slider
-        // Base slider adds offset for fine-tuning or longer echo effects
-        float totalDelayTime = ksDelayTimeSeconds + delayTimeSeconds;
-        int delaySamples = static_cast<int>(totalDelayTime * currentSampleRate);
-        delaySamples = std::clamp(delaySamples, 1, delayBufferSize - 1);
-
-        // Apply delay with lowpass filter in feedback
-        int readPos = (delayWritePos - delaySamples + delayBufferSize) % delayBufferSize;
-        float delayedSample = delayBuffer[readPos];
-
-        // Apply lowpass filter to feedback (one-pole filter)
-        delayFilterState = delayFilterState * delayFilterCoeff + delayedSample * (1.0f - delayFilterCoeff);
-        float filteredFeedback = delayFilterState;
-
-        delayBuffer[delayWritePos] = output + filteredFeedback * delayFeedback;
-        delayWritePos = (delayWritePos + 1) % delayBufferSize;
-        output = output + delayedSample * delayMix;
-
-        // 2. Apply ring modulator with sequencer modulation
-        if (ringModMix > 0.0f)
+        if constexpr ((features & DroneFeature) != 0)
+        {
+            vcaGainBuffer[i] = settings.vcaLevel;
+        }
+        else
+        {
+            float modulatedVcaEnvValue = vcaEnvValue;
+            if (vcaDecayMod > 0.0f)
+                modulatedVcaEnvValue = FastMath::pow(vcaEnvValue, 1.0f - vcaDecayMod * 0.8f);  // Slower decay
+            else if (vcaDecayMod < 0.0f)
+                modulatedVcaEnvValue = FastMath::pow(vcaEnvValue, 1.0f - vcaDecayMod * 2.0f);  // Faster decay
+            vcaGainBuffer[i] = modulatedVcaEnvValue * settings.vcaLevel;
+        }
+
+        // Ring mod frequency for this sample
+        if constexpr ((features & RingModFeature) != 0)
         {
-            // Sequencer modulates ring mod frequency (0-1 maps to 0.25x to 4x base freq)
-            float seqRingMod = sequencer.getCurrentRingMod();
-            float freqMult = 0.25f + seqRingMod * 3.75f;  // 0.25x to 4x
             // Apply mod matrix ring freq modulation (±2 octaves)
-            freqMult *= std::pow(2.0f, ringFreqMod * 2.0f);
-            double modulatedRingInc = ringModPhaseInc * freqMult;
+            ringFreqMultBuffer[i] = seqRingFreqMult * FastMath::exp2(ringFreqMod * 2.0f);
+        }
 
-            float ringModSignal = static_cast<float>(std::sin(ringModPhase * 2.0 * juce::MathConstants<double>::pi));
-            ringModPhase += modulatedRingInc;
-            if (ringModPhase >= 1.0)
-                ringModPhase -= 1.0;
+        // Per-step pan with mod matrix modulation
+        panBuffer[i] = std::clamp(seqPan + panMod, -1.0f, 1.0f);
+    }
+
+    // A closed VCA silences the whole voice, so the oscillators and filter pause until
+    // the next trigger (the FX below keep running for their tails)
+    if (vcaActive || (features & DroneFeature) != 0)
+    {
+        // Pitch octaves -> frequency multipliers, cutoff modulation octaves -> Hz
+        FastMath::exp2Block(vco1PitchBuffer.data(), vco1PitchBuffer.data(), blockSize);
+        FastMath::exp2Block(vco2PitchBuffer.data(), vco2PitchBuffer.data(), blockSize);
+        FastMath::exp2Block(filterCutoffBuffer.data(), filterCutoffBuffer.data(), blockSize);
+        for (int i = 0; i < blockSize; ++i)
+            filterCutoffBuffer[i] = std::clamp(settings.filterCutoff * filterCutoffBuffer[i], 20.0f, 20000.0f);
 
-            float ringModOutput = output * ringModSignal;
-            output = output * (1.0f - ringModMix) + ringModOutput * ringModMix;
+        renderOscillatorsAndFilter(blockSize, settings.hardSync, settings.subLevel);
+
+        // VCA
+        juce::FloatVectorOperations::multiply(filterOutputBuffer.data(), vcaGainBuffer.data(), blockSize);
+    }
+    else
+    {
+        juce::FloatVectorOperations::clear(filterOutputBuffer.data(), blockSize);
+
+        // Nothing to fade while the voice is silent
+        if (pendingOversamplingOrder != oversamplingOrder)
+        {
+            switchOversampling();
+            oversamplingFadeGain = 1.0f;
         }
+    }
 
-        // Apply per-step panning with mod matrix modulation
-        float pan = std::clamp(sequencer.getCurrentPan() + panMod, -1.0f, 1.0f);
-        float panAngle = (pan + 1.0f) * 0.25f * juce::MathConstants<float>::pi;
-        float leftGain = std::cos(panAngle);
-        float rightGain = std::sin(panAngle);
+    // 1. Karplus-Strong tuned delay over the sub-block (the step can't change within it)
+    resonator.setStep(sequencer.getCurrentStep());
+    fxStages[ResonatorStage].process(filterOutputBuffer.data(), nullptr, blockSize,
+        [this](float* samples, float*, int n) { resonator.process(samples, n); },
+        [this] { resonator.reset(); });
+
+    // 2. Ring modulator, its frequency modulated by the sequencer and mod matrix
+    fxStages[RingModStage].process(filterOutputBuffer.data(), nullptr, blockSize,
+        [this](float* samples, float*, int n) { ringMod.process(samples, ringFreqMultBuffer.data(), n); },
+        [this] { ringMod.reset(); });
+
+    // Pass 2: per-step panning with mod matrix modulation, straight into the output (the
+    // reverb runs over it after the whole block)
+    panner.process(filterOutputBuffer.data(), panBuffer.data(), leftChannel + blockStart,
+                   (features & StereoFeature) != 0 ? rightChannel + blockStart : nullptr, blockSize);
+}
 
-        // Output (store for reverb processing)
-        leftChannel[sample] = output * leftGain;
-        if (rightChannel != nullptr)
-            rightChannel[sample] = output * rightGain;
+void DFAMSynthAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
+                                            juce::MidiBuffer& midiMessages)
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    auto totalNumOutputChannels = getTotalNumOutputChannels();
+
+    // Clear buffer
+    for (auto i = 0; i < totalNumOutputChannels; ++i)
+        buffer.clear(i, 0, buffer.getNumSamples());
+
+    // Merge on-screen keyboard events (MIDI is applied at each event's position in the render loop)
+    keyboardState.processNextMidiBuffer(midiMessages, 0, buffer.getNumSamples(), true);
+
+    // Host sync - read tempo and transport from the DAW once per block
+    hostTransport = {};
+    if (auto* playHead = getPlayHead())
+    {
+        if (auto posInfo = playHead->getPosition())
+        {
+            hostTransport.valid = true;
+            if (posInfo->getBpm().hasValue())
+            {
+                hostTransport.hasBpm = true;
+                hostTransport.bpm = static_cast<float>(*posInfo->getBpm());
+            }
+            hostTransport.isPlaying = posInfo->getIsPlaying();
+        }
     }
 
-    // 3. Apply reverb (final stage, post-delay, post-ring)
-    if (reverbMix > 0.0f)
+    // Bring the parameter snapshot up to date
+    parameters.applyChanges();
+
+    // A new seed (from a state or preset load) restarts the random sources
+    const uint32_t seed = randomSeed.load();
+    if (seed != appliedRandomSeed)
+        applyRandomSeed(seed);
+
+    // Oversampling factor change: the voice fades over to it (see renderOscillatorsAndFilter)
+    pendingOversamplingOrder = std::clamp(parameters.getSnapshot().getInt(Param::oversampling), 0, MAX_OVERSAMPLING_ORDER);
+
+    updateBlockSettings();
+
+    // Check for manual trigger/advance
+    bool doManualTrigger = manualTrigger.exchange(false);
+    bool doManualAdvance = manualAdvance.exchange(false);
+
+    // Process audio
+    auto* leftChannel = buffer.getWritePointer(0);
+    auto* rightChannel = totalNumOutputChannels > 1 ? buffer.getWritePointer(1) : nullptr;
+
+    const int numSamples = buffer.getNumSamples();
+
+    auto midiIterator = midiMessages.cbegin();
+    const auto midiEnd = midiMessages.cend();
+
+    int blockSize = 0;
+    for (int blockStart = 0; blockStart < numSamples; blockStart += blockSize)
     {
-        // Create temp buffer for wet signal
-        std::vector<float> wetLeft(buffer.getNumSamples());
-        std::vector<float> wetRight(buffer.getNumSamples());
+        // Parameter changes that arrived while the previous sub-block was rendering
+        if (blockStart > 0 && parameters.applyChanges())
+            updateBlockSettings();
 
-        // Pre-delay: 30ms gives depth without being noticeable
-        int preDelaySamples = static_cast<int>(currentSampleRate * 0.03);
-        preDelaySamples = std::min(preDelaySamples, reverbPreDelaySize - 1);
+        // Apply MIDI events due at this sample
+        if (midiIterator != midiEnd && (*midiIterator).samplePosition <= blockStart)
+        {
+            for (; midiIterator != midiEnd && (*midiIterator).samplePosition <= blockStart; ++midiIterator)
+                handleMidiMessage((*midiIterator).getMessage());
+
+            updateOscillatorFrequencies();
+        }
+
+        // Process sequencer. Sub-blocks are split at step boundaries so a step can only
+        // trigger on the first sample and the step values are constant across the sub-block.
+        bool stepTrigger = sequencer.process();
 
-        // Apply pre-delay to reverb input
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        // Handle manual advance (only on first sample of block)
+        if (blockStart == 0 && doManualAdvance)
+        {
+            sequencer.advanceStep();
+            stepTrigger = true;
+        }
+
+        // Handle manual trigger
+        if (blockStart == 0 && doManualTrigger)
         {
-            // Read from pre-delay buffer
-            int readPos = (reverbPreDelayWritePos - preDelaySamples + reverbPreDelaySize) % reverbPreDelaySize;
-            wetLeft[i] = reverbPreDelayL[readPos];
-            wetRight[i] = reverbPreDelayR[readPos];
-
-            // Write current sample to pre-delay buffer
-            reverbPreDelayL[reverbPreDelayWritePos] = leftChannel[i];
-            reverbPreDelayR[reverbPreDelayWritePos] = rightChannel != nullptr ? rightChannel[i] : leftChannel[i];
-            reverbPreDelayWritePos = (reverbPreDelayWritePos + 1) % reverbPreDelaySize;
+            stepTrigger = true;
         }
 
-        // Process reverb in stereo
-        reverb.processStereo(wetLeft.data(), wetRight.data(), buffer.getNumSamples());
+        // Sub-block ends at the next MIDI event or step boundary
+        blockSize = std::min(SUB_BLOCK_SIZE, numSamples - blockStart);
+        if (midiIterator != midiEnd)
+            blockSize = std::min(blockSize, (*midiIterator).samplePosition - blockStart);
+        blockSize = std::min(blockSize - 1, sequencer.samplesUntilNextStep()) + 1;
+        sequencer.advance(blockSize - 1);
 
-        // Apply lowpass filter to reverb output and blend dry/wet
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        // In drone mode, don't retrigger envelopes - sound continues smoothly
+        if (stepTrigger && !settings.drone)
         {
-            // Filter the wet signal (one-pole lowpass) - softens harsh highs
-            reverbFilterStateL = reverbFilterStateL * reverbFilterCoeff + wetLeft[i] * (1.0f - reverbFilterCoeff);
-            reverbFilterStateR = reverbFilterStateR * reverbFilterCoeff + wetRight[i] * (1.0f - reverbFilterCoeff);
+            // Trigger all envelopes
+            float velocity = sequencer.getCurrentVelocity();
+            pitchEnv.trigger(velocity);
+            filterEnv.trigger(velocity);
+            vcaEnv.trigger(velocity);
+
+            // Start a fresh control-rate interval so the attack isn't held back
+            modSamplesUntilUpdate = 0;
+        }
+
+        // Envelopes, then the mod matrix (which uses them as sources). Triggers only
+        // happen on a sub-block's first sample, so each envelope renders as one block.
+        pitchEnv.render(pitchEnvBuffer.data(), blockSize);
+        filterEnv.render(filterEnvBuffer.data(), blockSize);
+        const bool vcaActive = vcaEnv.render(vcaEnvBuffer.data(), blockSize);
 
-            leftChannel[i] = leftChannel[i] * (1.0f - reverbMix) + reverbFilterStateL * reverbMix;
-            if (rightChannel != nullptr)
-                rightChannel[i] = rightChannel[i] * (1.0f - reverbMix) + reverbFilterStateR * reverbMix;
+        renderModulation(blockSize);
+
+        // Noise for the sub-block, scaled to the noise level in pass 1
+        noise.process(noiseMixBuffer.data(), blockSize);
+
+        // Pass 1, oscillators/filter/VCA, resonator and pass 2, compiled for the active features
+        const int features = getVoiceFeatures(rightChannel != nullptr);
+        (this->*voiceKernels[static_cast<size_t>(features)])(blockStart, blockSize, vcaActive, leftChannel, rightChannel);
+    }
+
+    // 3. Reverb (final stage, post-delay, post-ring), in chunks of the prepared block size
+    // in case the host sends a longer block
+    for (int chunkStart = 0; chunkStart < numSamples; chunkStart += maxBlockSize)
+    {
+        const int chunkSize = std::min(maxBlockSize, numSamples - chunkStart);
+        fxStages[ReverbStage].process(leftChannel + chunkStart,
+                                      rightChannel != nullptr ? rightChannel + chunkStart : nullptr, chunkSize,
+                                      [this](float* left, float* right, int n) { processReverb(left, right, n); },
+                                      [this] { resetReverb(); });
+    }
+
+    // Publish the sequencer position for the editor
+    displayedStep.store(sequencer.getCurrentStep(), std::memory_order_relaxed);
+    displayedRunning.store(sequencer.isRunning(), std::memory_order_relaxed);
+}
+
+void DFAMSynthAudioProcessor::updateReverbDecimation(float cutoff)
+{
+    const int decimation = reverb.chooseDecimation(cutoff);
+    if (decimation == reverb.getDecimation())
+        return;
+
+    // Nothing is ringing in a network that isn't running, so it can just be re-laid out.
+    // Nor once the convolution has taken over, but while the network is crossfading out into
+    // it, or ringing out an earlier change, the change waits until that has finished.
+    if (!fxStages[ReverbStage].isRunning() || (useConvolutionReverb && reverbCrossfadeRemaining == 0))
+    {
+        reverb.setDecimation(decimation);
+        return;
+    }
+
+    if (useConvolutionReverb || reverbRingOutRemaining > 0)
+        return;
+
+    // The settings that follow are applied to the network taking over
+    std::swap(reverb, ringingReverb);
+    ringingReverb.setMix(1.0f);
+    reverbRingOutRemaining = ringingReverb.getDecaySamples();
+    reverb.setDecimation(decimation);
+    reverb.reset();
+}
+
+void DFAMSynthAudioProcessor::processReverb(float* left, float* right, int numSamples)
+{
+    // The engine being left only runs for the samples of the crossfade
+    const int crossfade = std::min(numSamples, reverbCrossfadeRemaining);
+    if (crossfade > 0)
+    {
+        float* const oldRight = right != nullptr ? reverbCrossfadeRight : nullptr;
+        juce::FloatVectorOperations::copy(reverbCrossfadeLeft, left, crossfade);
+        if (right != nullptr)
+            juce::FloatVectorOperations::copy(reverbCrossfadeRight, right, crossfade);
+
+        if (useConvolutionReverb)
+            reverb.process(reverbCrossfadeLeft, oldRight, crossfade);
+        else
+            convolutionReverb.process(reverbCrossfadeLeft, oldRight, crossfade);
+    }
+
+    if (useConvolutionReverb)
+        convolutionReverb.process(left, right, numSamples);
+    else
+        reverb.process(left, right, numSamples);
+
+    if (crossfade > 0)
+    {
+        const float step = 1.0f / static_cast<float>(reverbCrossfadeLength);
+        for (int i = 0; i < crossfade; ++i)
+        {
+            const float oldGain = static_cast<float>(reverbCrossfadeRemaining - i) * step;
+            left[i] += (reverbCrossfadeLeft[i] - left[i]) * oldGain;
+            if (right != nullptr)
+                right[i] += (reverbCrossfadeRight[i] - right[i]) * oldGain;
         }
+        reverbCrossfadeRemaining -= crossfade;
     }
+
+    // The network being left rings out on silence, fading over the last crossfade length
+    const int ringOut = std::min(numSamples, reverbRingOutRemaining);
+    if (ringOut > 0)
+    {
+        float* const ringRight = right != nullptr ? reverbCrossfadeRight : nullptr;
+        juce::FloatVectorOperations::clear(reverbCrossfadeLeft, ringOut);
+        if (right != nullptr)
+            juce::FloatVectorOperations::clear(reverbCrossfadeRight, ringOut);
+        ringingReverb.process(reverbCrossfadeLeft, ringRight, ringOut);
+
+        const float mix = reverb.getMix();
+        const float step = 1.0f / static_cast<float>(reverbCrossfadeLength);
+        for (int i = 0; i < ringOut; ++i)
+        {
+            const float gain = mix * std::min(1.0f, static_cast<float>(reverbRingOutRemaining - i) * step);
+            left[i] += reverbCrossfadeLeft[i] * gain;
+            if (right != nullptr)
+                right[i] += reverbCrossfadeRight[i] * gain;
+        }
+        reverbRingOutRemaining -= ringOut;
+    }
+}
+
+void DFAMSynthAudioProcessor::resetReverb()
+{
+    reverb.reset();
+    convolutionReverb.reset();
+    reverbCrossfadeRemaining = 0;
+    reverbRingOutRemaining = 0;
 }
 
 bool DFAMSynthAudioProcessor::hasEditor() const
@@ -1117,7 +1538,11 @@ void DFAMSynthAudioProcessor::setStateInformation(const void* data, int sizeInBy
 
     if (xmlState.get() != nullptr)
         if (xmlState->hasTagName(apvts.state.getType()))
+        {
             apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
+            restoreRandomSeed();
+            restoreReverbImpulse();
+        }
 }
 
 juce::File DFAMSynthAudioProcessor::getPresetsFolder()
@@ -1153,7 +1578,11 @@ void DFAMSynthAudioProcessor::loadPreset(const juce::File& presetFile)
     std::unique_ptr<juce::XmlElement> xml = juce::XmlDocument::parse(presetFile);
 
     if (xml != nullptr && xml->hasTagName(apvts.state.getType()))
+    {
         apvts.replaceState(juce::ValueTree::fromXml(*xml));
+        restoreRandomSeed();
+        restoreReverbImpulse();
+    }
 }
 
 void DFAMSynthAudioProcessor::refreshPresetList()
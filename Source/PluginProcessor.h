@@ -1,13 +1,30 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "DSP/Oscillator.h"
+#include "DSP/OscillatorBank.h"
 #include "DSP/Envelope.h"
 #include "DSP/NoiseGenerator.h"
+#include "DSP/RandomStream.h"
 #include "DSP/LadderFilter.h"
+#include "DSP/DelayLine.h"
+#include "DSP/KarplusStrong.h"
+#include "DSP/RingModulator.h"
+#include "DSP/QuadratureOscillator.h"
+#include "DSP/StereoReverb.h"
+#include "DSP/ConvolutionReverb.h"
+#include "DSP/FxStage.h"
+#include "DSP/HalfBandFilter.h"
+#include "DSP/StereoPanner.h"
+#include "DSP/ModMatrix.h"
+#include "DSP/ScratchArena.h"
+#include "DSP/SimdDispatch.h"
 #include "Sequencer/Sequencer.h"
+#include "Parameters/ParameterState.h"
 
-class DFAMSynthAudioProcessor : public juce::AudioProcessor
+namespace Benchmarks { struct VoiceKernelBenchmark; }
+
+class DFAMSynthAudioProcessor : public juce::AudioProcessor,
+                                private juce::AsyncUpdater
 {
 public:
     DFAMSynthAudioProcessor();
@@ -51,93 +68,230 @@ public:
     juce::StringArray presetNames;
     juce::Array<juce::File> presetFiles;
 
-    // For UI to display current step
-    int getCurrentSequencerStep() const { return sequencer.getCurrentStep(); }
-    bool isSequencerRunning() const { return sequencer.isRunning(); }
+    // For UI to display current step (published by the audio thread after each block)
+    int getCurrentSequencerStep() const { return displayedStep.load(std::memory_order_relaxed); }
+    bool isSequencerRunning() const { return displayedRunning.load(std::memory_order_relaxed); }
 
     // Manual trigger and advance (called from UI)
     void triggerManual() { manualTrigger.store(true); }
     void advanceManual() { manualAdvance.store(true); }
 
+    // Seed of the noise, S&H LFO and random mod source. Saved with the state and presets;
+    // renders started from prepareToPlay with the same seed and input are bit-identical.
+    void setRandomSeed(uint32_t seed);
+    uint32_t getRandomSeed() const { return randomSeed.load(); }
+
+    // Impulse response for the convolution reverb, loaded in the background. The path is
+    // saved with the state and presets; an unreadable file leaves the current IR in place
+    // and returns false.
+    bool loadReverbImpulse(const juce::File& file);
+    juce::File getReverbImpulse() const;
+
+    // Diagnostics: the SIMD kernel set chosen for this CPU, e.g. "AVX2"
+    juce::String getSimdVariantName() const { return SimdDispatch::getVariantName(SimdDispatch::getKernels().variant); }
+
 private:
+    friend struct Benchmarks::VoiceKernelBenchmark;  // times voiceKernels directly
+
     // DSP Components
-    Oscillator vco1;
-    Oscillator vco2;
-    Oscillator subOsc;
+    OscillatorBank oscillators;  // VCO1, VCO2 and sub
     NoiseGenerator noise;
     LadderFilter filter;
     Envelope pitchEnv;   // VCO decay envelope
     Envelope filterEnv;
     Envelope vcaEnv;
     Sequencer sequencer;
+    StereoPanner panner;  // voice -> output channels
 
-    // Delay
-    std::vector<float> delayBuffer;
-    int delayWritePos = 0;
-    int delayBufferSize = 0;
-    double currentSampleRate = 44100.0;
-    float delayFilterState = 0.0f;  // Simple one-pole lowpass state
+    // Delay lines and block-length stage buffers, carved from one allocation made in
+    // prepareToPlay so processBlock never allocates
+    ScratchArena arena;
+    int maxBlockSize = 0;  // stage buffer length; longer host blocks are processed in chunks
 
-    // Reverb
-    juce::Reverb reverb;
-    juce::Reverb::Parameters reverbParams;
-
-    // Reverb pre-delay buffer
-    std::vector<float> reverbPreDelayL;
-    std::vector<float> reverbPreDelayR;
-    int reverbPreDelayWritePos = 0;
-    int reverbPreDelaySize = 0;
+    double currentSampleRate = 44100.0;
 
-    // Ring modulator oscillator
-    double ringModPhase = 0.0;
-    double ringModPhaseInc = 0.0;
+    // === FX CHAIN: Delay (Karplus-Strong resonator tuned per step) -> Ring Mod -> Reverb ===
+    // The delay and ring mod run per sub-block on the mono voice, the reverb per host block
+    // on the panned output. A stage is enabled while its mix is up and idles once its tail
+    // has died away.
+    enum FxStageId { ResonatorStage, RingModStage, ReverbStage, NUM_FX_STAGES };
+    std::array<FxStage, NUM_FX_STAGES> fxStages;
+    std::atomic<double> tailLengthSeconds { 0.0 };  // longest tail hold of the enabled stages
+    KarplusStrong resonator;
+    RingModulator ringMod;
+    StereoReverb reverb;
+    ConvolutionReverb convolutionReverb;  // used instead of the network once an IR is loaded
+    bool useConvolutionReverb = false;
+
+    // On a change of reverb engine the new one starts clear, and the one being left keeps
+    // running on a copy of the input while its output crossfades to the new one's
+    static constexpr double REVERB_CROSSFADE_SECONDS = 0.02;
+    int reverbCrossfadeLength = 1;
+    int reverbCrossfadeRemaining = 0;
+    float* reverbCrossfadeLeft = nullptr;
+    float* reverbCrossfadeRight = nullptr;
+
+    // On a change of the network's decimation the network moves here and rings out on
+    // silence, its wet output added to the new one's, so the tail carries on. A further
+    // change waits until it has finished.
+    StereoReverb ringingReverb;
+    int reverbRingOutRemaining = 0;
+
+    void updateReverbDecimation(float cutoff);
+    void processReverb(float* left, float* right, int numSamples);
+    void resetReverb();
+
+    // Voice loop runs in sub-blocks: per-sample modulation is gathered first so the
+    // oscillators and filter can process a whole sub-block, then VCA/FX run over the result
+    static constexpr int SUB_BLOCK_SIZE = 64;
+    std::array<float, SUB_BLOCK_SIZE> vco1PitchBuffer = {};  // frequency multipliers
+    std::array<float, SUB_BLOCK_SIZE> vco2PitchBuffer = {};
+    std::array<float, SUB_BLOCK_SIZE> vco1WaveBuffer = {};
+    std::array<float, SUB_BLOCK_SIZE> vco2WaveBuffer = {};
+    std::array<float, SUB_BLOCK_SIZE> fmAmountBuffer = {};
+    std::array<float, SUB_BLOCK_SIZE> vco1LevelBuffer = {};
+    std::array<float, SUB_BLOCK_SIZE> vco2LevelBuffer = {};
+    std::array<float, SUB_BLOCK_SIZE> noiseMixBuffer = {};
+    std::array<float, SUB_BLOCK_SIZE> filterInputBuffer = {};
+    std::array<float, SUB_BLOCK_SIZE> filterCutoffBuffer = {};
+    std::array<float, SUB_BLOCK_SIZE> filterResBuffer = {};
+    std::array<float, SUB_BLOCK_SIZE> filterOutputBuffer = {};
+    std::array<float, SUB_BLOCK_SIZE> vcaGainBuffer = {};
+    std::array<float, SUB_BLOCK_SIZE> ringFreqMultBuffer = {};
+    std::array<float, SUB_BLOCK_SIZE> panBuffer = {};
+
+    // Oversampling of the oscillator -> filter section. The oscillators render straight at
+    // the oversampled rate, so only the way down needs filtering: a half-band decimator per
+    // halving, the first taking the highest rate.
+    static constexpr int MAX_OVERSAMPLING_ORDER = 3;  // 8x
+    std::array<HalfBandFilter<1>, MAX_OVERSAMPLING_ORDER> decimators;
+    int oversamplingOrder = 0;
+    std::array<float, SUB_BLOCK_SIZE << MAX_OVERSAMPLING_ORDER> oversampledBuffer = {};
+    std::array<float, SUB_BLOCK_SIZE << MAX_OVERSAMPLING_ORDER> oversampledCutoffBuffer = {};
+    std::array<float, SUB_BLOCK_SIZE << MAX_OVERSAMPLING_ORDER> oversampledResBuffer = {};
+
+    // A new factor from the parameter waits while the voice fades out at the old one, then
+    // the voice restarts at the new rate and fades back in. The host hears about the new
+    // latency from the message thread.
+    static constexpr double OVERSAMPLING_FADE_SECONDS = 0.002;
+    int pendingOversamplingOrder = 0;
+    float oversamplingFadeGain = 1.0f;
+    float oversamplingFadeStep = 1.0f;
+    std::atomic<int> voiceLatency { 0 };
+
+    int prepareVoiceSampleRate();  // returns the voice's latency in host samples
+    void switchOversampling();
+    void renderOscillatorsAndFilter(int numSamples, bool hardSync, float subLevel);
+    void handleAsyncUpdate() override;
+
+    // Voice features that change the render path. The mask is taken once per sub-block and
+    // selects a renderVoice compiled for exactly those features, so its per-sample loops
+    // don't branch on them (hard sync, the sub and the filter mode specialise the same way
+    // inside OscillatorBank and LadderFilter)
+    enum VoiceFeature
+    {
+        SeqPitchVco1Feature = 1 << 0,  // sequencer pitch (with glide) reaches VCO1
+        SeqPitchVco2Feature = 1 << 1,  // ... and VCO2
+        DroneFeature = 1 << 2,
+        RingModFeature = 1 << 3,  // ring mod stage enabled (its frequency is gathered in pass 1)
+        StereoFeature = 1 << 4,
+        NUM_VOICE_KERNELS = 1 << 5
+    };
+
+    using VoiceKernel = void (DFAMSynthAudioProcessor::*)(int, int, bool, float*, float*);
+    static const std::array<VoiceKernel, NUM_VOICE_KERNELS> voiceKernels;
+
+    int getVoiceFeatures(bool stereo) const;
+
+    // Pass 1 (per-sample controls), oscillators -> filter -> VCA, the delay and ring mod
+    // stages, then pan for one sub-block
+    template <int features>
+    void renderVoice(int blockStart, int blockSize, bool vcaActive, float* leftChannel, float* rightChannel);
+
+    template <size_t... masks>
+    static std::array<VoiceKernel, sizeof...(masks)> makeVoiceKernels(std::index_sequence<masks...>);
 
     // Manual trigger/advance flags
     std::atomic<bool> manualTrigger { false };
     std::atomic<bool> manualAdvance { false };
 
+    // Sequencer position for the editor
+    std::atomic<int> displayedStep { 0 };
+    std::atomic<bool> displayedRunning { false };
+
+    // Random sources: one counter-based stream each, all keyed by the seed
+    enum RandomStreamId : uint32_t { NoiseStream, LfoStream, ModStream };
+    std::atomic<uint32_t> randomSeed { 0 };
+    uint32_t appliedRandomSeed = 0;  // audio thread's copy; reseeds when randomSeed changes
+    RandomStream lfoRandom;
+    RandomStream modRandom;
+
+    // Seed every stream and restart the random sources
+    void applyRandomSeed(uint32_t seed);
+
+    // Take the seed from the parameter tree after a state or preset load (or store the
+    // current one if the loaded state predates seeds)
+    void restoreRandomSeed();
+
+    // Reload the impulse response named in the parameter tree, if any, after a state or
+    // preset load
+    void restoreReverbImpulse();
+
     // Parameter tree
     juce::AudioProcessorValueTreeState apvts;
 
     // Parameter layout creation
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
-    // Parameter pointers for efficient access
-    // VCO section
-    std::atomic<float>* vcoDecayParam = nullptr;
-    std::atomic<float>* seqPitchModParam = nullptr;  // 0=VCO1&2, 1=OFF, 2=VCO2
-    std::atomic<float>* vco1EgAmtParam = nullptr;    // bipolar -1 to +1
-    std::atomic<float>* vco1FreqParam = nullptr;
-    std::atomic<float>* vco1WaveParam = nullptr;
-    std::atomic<float>* vco1LevelParam = nullptr;
-    std::atomic<float>* subLevelParam = nullptr;
-    std::atomic<float>* noiseLevelParam = nullptr;
-
-    std::atomic<float>* fmAmountParam = nullptr;
-    std::atomic<float>* hardSyncParam = nullptr;
-    std::atomic<float>* vco2EgAmtParam = nullptr;    // bipolar -1 to +1
-    std::atomic<float>* vco2FreqParam = nullptr;
-    std::atomic<float>* vco2WaveParam = nullptr;
-    std::atomic<float>* vco2LevelParam = nullptr;
-
-    // Filter section
-    std::atomic<float>* filterCutoffParam = nullptr;
-    std::atomic<float>* filterModeParam = nullptr;   // 0=LP, 1=HP
-    std::atomic<float>* filterResParam = nullptr;
-    std::atomic<float>* vcaEgModeParam = nullptr;    // 0=fast, 1=slow
-    std::atomic<float>* vcaLevelParam = nullptr;
-
-    std::atomic<float>* filterDecayParam = nullptr;
-    std::atomic<float>* filterEnvAmtParam = nullptr; // bipolar
-    std::atomic<float>* noiseVcfModParam = nullptr;  // bipolar
-    std::atomic<float>* vcaDecayParam = nullptr;
-
-    // Sequencer section
-    std::atomic<float>* tempoParam = nullptr;
-    std::atomic<float>* tempoMultParam = nullptr;
-    std::atomic<float>* seqRunParam = nullptr;
-    std::atomic<float>* glideParam = nullptr;
-    std::atomic<float>* droneParam = nullptr;
+    // Audio-thread parameter snapshot, kept current through a lock-free change queue
+    ParameterState parameters;
+
+    // Values derived from the parameter snapshot. Recomputed at the start of each block
+    // and whenever queued parameter changes are applied between sub-blocks.
+    struct BlockSettings
+    {
+        int seqPitchMod = 0;  // 0=VCO1&2, 1=OFF, 2=VCO2
+        float vco1EgAmt = 0.0f;
+        float vco1Freq = 0.0f;
+        float vco1Wave = 0.33f;
+        float vco1Level = 0.5f;
+        float vco2EgAmt = 0.0f;
+        float vco2Freq = 0.0f;
+        float vco2Wave = 0.33f;
+        float vco2Level = 0.5f;
+        float subLevel = 0.0f;
+        float noiseLevel = 0.0f;
+        float fmAmount = 0.0f;
+        bool hardSync = false;
+
+        float filterCutoff = 1000.0f;
+        float filterRes = 0.0f;
+        float filterEnvAmt = 0.0f;
+        float noiseVcfMod = 0.0f;
+        float vcaLevel = 1.0f;
+
+        bool drone = false;
+        float glideAmount = 0.0f;
+        float glideCoeff = 1.0f;
+        float waveSmooth = 1.0f;
+
+        int lfoWave = 0;
+        double lfoPhaseInc = 0.0;
+        int modInterval = 1;  // samples between mod matrix evaluations (1 = audio rate)
+    };
+    BlockSettings settings;
+
+    // Host tempo and transport, read once per block for host sync
+    struct HostTransport
+    {
+        bool valid = false;
+        bool hasBpm = false;
+        float bpm = 120.0f;
+        bool isPlaying = false;
+    };
+    HostTransport hostTransport;
+
+    void updateBlockSettings();
 
     // Glide/portamento state
     float currentGlidePitch = 0.0f;
@@ -152,42 +306,11 @@ private:
     float midiNotePitch = 0.0f;  // Pitch offset from MIDI (semitones from C2)
     bool midiNoteActive = false;
     int lastMidiNote = -1;
-    std::atomic<float>* midiHoldParam = nullptr;
-
-    std::array<std::atomic<float>*, 8> seqPitchParams = {};
-    std::array<std::atomic<float>*, 8> seqVelParams = {};
-    std::array<std::atomic<float>*, 8> seqPanParams = {};
-    std::array<std::atomic<float>*, 8> seqWaveParams = {};
-    std::array<std::atomic<float>*, 8> seqRingModParams = {};
-    std::array<std::atomic<float>*, 8> seqDelayPitchParams = {};
-
-    // Delay parameters
-    std::atomic<float>* delayTimeParam = nullptr;
-    std::atomic<float>* delayFeedbackParam = nullptr;
-    std::atomic<float>* delayFilterParam = nullptr;
-    std::atomic<float>* delayMixParam = nullptr;
-
-    // Reverb parameters
-    std::atomic<float>* reverbDecayParam = nullptr;
-    std::atomic<float>* reverbFilterParam = nullptr;
-    std::atomic<float>* reverbMixParam = nullptr;
-
-    // Reverb filter state
-    float reverbFilterStateL = 0.0f;
-    float reverbFilterStateR = 0.0f;
-
-    // Sequencer swing/direction
-    std::atomic<float>* swingParam = nullptr;
-    std::atomic<float>* seqDirectionParam = nullptr;
-    std::atomic<float>* hostSyncParam = nullptr;
-
-    // Ring modulator parameters
-    std::atomic<float>* ringModFreqParam = nullptr;
-    std::atomic<float>* ringModMixParam = nullptr;
-
-    // Scale quantization parameters
-    std::atomic<float>* scaleTypeParam = nullptr;
-    std::atomic<float>* scaleRootParam = nullptr;
+
+    // MIDI events are applied at their sample position: the render loop splits its
+    // sub-blocks at event offsets and retunes the oscillators in between
+    void handleMidiMessage(const juce::MidiMessage& message);
+    void updateOscillatorFrequencies();
 
     // Scale quantization helper
     float quantizePitchToScale(float pitchSemitones, int scaleType, int root);
@@ -195,18 +318,46 @@ private:
     // === MOD MATRIX ===
     // LFO
     double lfoPhase = 0.0;
-    std::atomic<float>* lfoRateParam = nullptr;
-    std::atomic<float>* lfoWaveParam = nullptr;
-    std::atomic<float>* lfoSyncParam = nullptr;  // tempo sync on/off
+    float lfoHoldValue = 0.0f;   // S&H output, redrawn when the phase wraps
+    float lfoLastPhase = 0.0f;
+    QuadratureOscillator lfoSine;  // sine wave at audio rate, restarted from lfoPhase each sub-block
 
-    // Mod slots (4 slots)
-    static constexpr int NUM_MOD_SLOTS = 4;
-    std::array<std::atomic<float>*, NUM_MOD_SLOTS> modSrcParams = {};
-    std::array<std::atomic<float>*, NUM_MOD_SLOTS> modDstParams = {};
-    std::array<std::atomic<float>*, NUM_MOD_SLOTS> modAmtParams = {};
+    // Random mod source: a new value ~50 times a second
+    float randomModValue = 0.0f;
+    int randomModCounter = 0;
+
+    // Mod slots, compiled into a routing table
+    ModMatrix modMatrix;
 
     // Mod matrix helper
     float generateLFO(float waveform);
 
+    // Envelope outputs for the current sub-block (mod sources as well as voice controls)
+    std::array<float, SUB_BLOCK_SIZE> pitchEnvBuffer = {};
+    std::array<float, SUB_BLOCK_SIZE> filterEnvBuffer = {};
+    std::array<float, SUB_BLOCK_SIZE> vcaEnvBuffer = {};
+
+    // Mod sources (-1 to +1) for the current sub-block; only routed sources are filled
+    std::array<std::array<float, SUB_BLOCK_SIZE>, ModMatrix::NUM_SOURCES> modSourceBuffers = {};
+
+    // Per-sample mod matrix output for the current sub-block
+    std::array<std::array<float, SUB_BLOCK_SIZE>, ModMatrix::NUM_DESTINATIONS> modBuffers = {};
+
+    // Control-rate ramps: each evaluation becomes the target of a linear ramp that
+    // reaches it at the end of the interval
+    ModMatrix::Values modRampValues = {};
+    ModMatrix::Values modRampTargets = {};
+    ModMatrix::Values modRampIncrements = {};
+    int modSamplesUntilUpdate = 0;
+
+    // Sum every mod slot into values, reading the envelope sources at sample. The LFO and
+    // random source then advance by numSamples.
+    void evaluateModMatrix(int sample, int numSamples, ModMatrix::Values& values);
+    float advanceRandomModValue(int numSamples);
+    void renderModSources(int numSamples);
+
+    // Fill modBuffers for numSamples, at audio rate or ramped at settings.modInterval
+    void renderModulation(int numSamples);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DFAMSynthAudioProcessor)
 };
@@ -1,5 +1,6 @@
 #include "Sequencer.h"
 #include <cmath>
+#include <limits>
 
 Sequencer::Sequencer()
 {
@@ -22,7 +23,9 @@ void Sequencer::prepare(double newSampleRate)
 void Sequencer::reset()
 {
     currentStep = 0;
-    sampleCounter = 0.0;
+    stepStartOffset = 0.0;
+    samplesIntoStep = 0;
+    pingPongDir = 1;
 }
 
 void Sequencer::setTempo(float bpm)
@@ -89,29 +92,9 @@ void Sequencer::setDirection(int dir)
 
 void Sequencer::advanceStep()
 {
-    if (direction == 0)  // Forward
-    {
-        currentStep = (currentStep + 1) % NUM_STEPS;
-    }
-    else if (direction == 1)  // Backward
-    {
-        currentStep = (currentStep - 1 + NUM_STEPS) % NUM_STEPS;
-    }
-    else  // Pingpong
-    {
-        currentStep += pingPongDir;
-        if (currentStep >= NUM_STEPS - 1)
-        {
-            currentStep = NUM_STEPS - 1;
-            pingPongDir = -1;
-        }
-        else if (currentStep <= 0)
-        {
-            currentStep = 0;
-            pingPongDir = 1;
-        }
-    }
-    sampleCounter = 0.0;
+    moveToNextStep();
+    stepStartOffset = 0.0;
+    samplesIntoStep = 0;
 }
 
 bool Sequencer::process()
@@ -119,62 +102,75 @@ bool Sequencer::process()
     if (!running)
         return false;
 
-    bool triggered = false;
+    if (samplesUntilNextStep() > 0)
+    {
+        ++samplesIntoStep;
+        return false;
+    }
 
-    // Check if we need to advance to the next step
-    sampleCounter += 1.0;
+    // Carry the fractional remainder into the new step so swing timing stays exact
+    stepStartOffset = stepStartOffset + (samplesIntoStep + 1) - getCurrentStepLength();
+    samplesIntoStep = 0;
+    moveToNextStep();
+    return true;
+}
 
-    // Calculate swing-adjusted step length
+int Sequencer::samplesUntilNextStep() const
+{
+    if (!running)
+        return std::numeric_limits<int>::max();
+
+    // The step triggers on the first sample where the elapsed count reaches the step length
+    double remaining = getCurrentStepLength() - stepStartOffset - samplesIntoStep;
+    int samplesUntilTrigger = static_cast<int>(std::ceil(remaining)) - 1;
+    return std::max(samplesUntilTrigger, 0);
+}
+
+void Sequencer::advance(int numSamples)
+{
+    jassert(numSamples <= samplesUntilNextStep());
+
+    if (running)
+        samplesIntoStep += numSamples;
+}
+
+double Sequencer::getCurrentStepLength() const
+{
     // Swing delays odd steps (off-beats): swing=0.5 means no swing
     // swing=0.75 means off-beats are delayed by 50% of step length
-    double currentStepLength = samplesPerStep;
+    // swing 0.5 = normal, swing 1.0 = maximum delay (triplet feel)
+    double swingOffset = (swing - 0.5) * 2.0;  // -1 to +1
     bool isOffBeat = (currentStep % 2) == 1;
 
-    if (isOffBeat)
+    // Off-beats are lengthened and on-beats shortened by the same amount
+    return isOffBeat ? samplesPerStep * (1.0 + swingOffset * 0.5)
+                     : samplesPerStep * (1.0 - swingOffset * 0.5);
+}
+
+void Sequencer::moveToNextStep()
+{
+    if (direction == 0)  // Forward
     {
-        // Off-beat: adjust timing based on swing
-        // swing 0.5 = normal, swing 1.0 = maximum delay (triplet feel)
-        double swingOffset = (swing - 0.5) * 2.0;  // -1 to +1
-        currentStepLength = samplesPerStep * (1.0 + swingOffset * 0.5);
+        currentStep = (currentStep + 1) % NUM_STEPS;
     }
-    else
+    else if (direction == 1)  // Backward
     {
-        // On-beat: compensate for swing
-        double swingOffset = (swing - 0.5) * 2.0;
-        currentStepLength = samplesPerStep * (1.0 - swingOffset * 0.5);
+        currentStep = (currentStep - 1 + NUM_STEPS) % NUM_STEPS;
     }
-
-    if (sampleCounter >= currentStepLength)
+    else  // Pingpong
     {
-        sampleCounter -= currentStepLength;
-
-        // Advance step based on direction
-        if (direction == 0)  // Forward
-        {
-            currentStep = (currentStep + 1) % NUM_STEPS;
-        }
-        else if (direction == 1)  // Backward
+        currentStep += pingPongDir;
+        if (currentStep >= NUM_STEPS - 1)
         {
-            currentStep = (currentStep - 1 + NUM_STEPS) % NUM_STEPS;
+            currentStep = NUM_STEPS - 1;
+            pingPongDir = -1;
         }
-        else  // Pingpong
+        else if (currentStep <= 0)
         {
-            currentStep += pingPongDir;
-            if (currentStep >= NUM_STEPS - 1)
-            {
-                currentStep = NUM_STEPS - 1;
-                pingPongDir = -1;
-            }
-            else if (currentStep <= 0)
-            {
-                currentStep = 0;
-                pingPongDir = 1;
-            }
+            currentStep = 0;
+            pingPongDir = 1;
         }
-        triggered = true;
     }
-
-    return triggered;
 }
 
 float Sequencer::getCurrentPitchMultiplier() const
@@ -185,6 +181,11 @@ float Sequencer::getCurrentPitchMultiplier() const
     return std::pow(2.0f, semitones / 12.0f);
 }
 
+float Sequencer::getCurrentPitch() const
+{
+    return stepPitch[currentStep];
+}
+
 float Sequencer::getCurrentVelocity() const
 {
     return stepVelocity[currentStep];
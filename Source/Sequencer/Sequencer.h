@@ -54,9 +54,21 @@ public:
     // Process one sample. Returns true if a new step was triggered this sample.
     bool process();
 
+    // Scheduler: number of samples that can be advanced before the sample that triggers
+    // the next step (0 = the next process() call triggers). Returns INT_MAX when stopped.
+    // Step boundaries are computed from the step start, so trigger positions don't depend
+    // on how the caller splits its blocks.
+    int samplesUntilNextStep() const;
+
+    // Advance without triggering. numSamples must not exceed samplesUntilNextStep().
+    void advance(int numSamples);
+
     // Get the current step's pitch multiplier (for oscillator frequency)
     float getCurrentPitchMultiplier() const;
 
+    // Get the current step's pitch (semitones)
+    float getCurrentPitch() const;
+
     // Get the current step's velocity
     float getCurrentVelocity() const;
 
@@ -72,11 +84,15 @@ public:
     // Get the current step's delay pitch (semitones)
     float getCurrentDelayPitch() const;
 
+    // Get a step's delay pitch as set, after clamping (semitones)
+    float getStepDelayPitch(int step) const { return stepDelayPitch[step]; }
+
 private:
     double sampleRate = 44100.0;
     float tempo = 120.0f;          // BPM
     double samplesPerStep = 0.0;
-    double sampleCounter = 0.0;
+    double stepStartOffset = 0.0;  // fractional samples already elapsed when the step began
+    int samplesIntoStep = 0;       // whole samples since the step began
     int currentStep = 0;
     bool running = false;
     float swing = 0.5f;            // 0-1, where 0.5 = no swing
@@ -91,4 +107,6 @@ private:
     std::array<float, NUM_STEPS> stepDelayPitch = {}; // semitones for Karplus-Strong delay tuning
 
     void updateTiming();
+    double getCurrentStepLength() const;
+    void moveToNextStep();
 };
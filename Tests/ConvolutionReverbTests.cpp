@@ -0,0 +1,80 @@
+#include "DSPTests.h"
+#include "DSP/ConvolutionReverb.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    constexpr double SAMPLE_RATE = 48000.0;
+    constexpr int BLOCK_SIZE = 512;
+
+    // A direct sound and two reflections, 200 samples apart, the middle one four times as
+    // loud. The IR starts and ends on a tap, so trimming its silence leaves it as it is.
+    constexpr int REFLECTION_SPACING = 200;
+
+    juce::File writeImpulseResponse()
+    {
+        juce::AudioBuffer<float> ir(1, 2 * REFLECTION_SPACING + 1);
+        ir.clear();
+        ir.setSample(0, 0, 0.125f);
+        ir.setSample(0, REFLECTION_SPACING, 0.5f);
+        ir.setSample(0, 2 * REFLECTION_SPACING, 0.125f);
+
+        const auto file = juce::File::createTempFile(".wav");
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(new juce::FileOutputStream(file), SAMPLE_RATE,
+                                                                            1, 24, {}, 0));
+        writer->writeFromAudioSampleBuffer(ir, 0, ir.getNumSamples());
+        return file;
+    }
+
+    // Poll as the processor does between blocks, until the background load has been taken up
+    bool waitForImpulseResponse(ConvolutionReverb& reverb)
+    {
+        const auto start = juce::Time::getMillisecondCounter();
+        while (!reverb.hasImpulseResponse() && juce::Time::getMillisecondCounter() - start < 2000)
+        {
+            reverb.pollImpulseResponse();
+            juce::Thread::sleep(1);
+        }
+        return reverb.hasImpulseResponse();
+    }
+}
+
+void DSPTests::runConvolutionReverbTests()
+{
+    const char* const name = "ConvolutionReverb";
+
+    std::vector<float> storage(static_cast<size_t>(ConvolutionReverb::getRequiredStorage(BLOCK_SIZE)));
+    ConvolutionReverb reverb;
+    reverb.prepare(SAMPLE_RATE, BLOCK_SIZE, storage.data());
+    reverb.setFilterCutoff(20000.0f);
+    reverb.setMix(1.0f);
+
+    // The load finishes on the background thread, so the IR isn't reported straight away
+    const auto file = writeImpulseResponse();
+    const bool accepted = reverb.loadImpulseResponse(file);
+    expect(name, "IR file accepted", accepted);
+    expect(name, "not reported before the engine has taken it up", !reverb.hasImpulseResponse());
+    expect(name, "taken up within 2 s of polling", waitForImpulseResponse(reverb));
+    file.deleteFile();
+
+    // The impulse comes back as the IR, without latency
+    reverb.reset();
+    std::vector<float> left(BLOCK_SIZE, 0.0f);
+    std::vector<float> right(BLOCK_SIZE, 0.0f);
+    left[0] = 1.0f;
+    right[0] = 1.0f;
+    reverb.process(left.data(), right.data(), BLOCK_SIZE);
+
+    const auto peak = std::max_element(left.begin(), left.end(),
+                                       [](float a, float b) { return std::abs(a) < std::abs(b); });
+    report(name, "peak offset from the IR's, samples", std::abs(static_cast<double>(peak - left.begin()) - REFLECTION_SPACING), 0.0);
+    report(name, "direct sound re reflection, error", std::abs(left[0] / *peak - 0.25), 0.01);
+
+    // Clearing takes effect at once; the network takes over straight away
+    reverb.clearImpulseResponse();
+    expect(name, "cleared IR reported at once", !reverb.hasImpulseResponse());
+}
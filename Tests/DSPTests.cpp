@@ -0,0 +1,85 @@
+// DSP component and processor checks (run with ctest). Each component's checks are in its
+// own file; this runs them in turn and prints one line per check.
+//
+// Returns non-zero if any check fails.
+
+#include "DSPTests.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+
+namespace
+{
+    int failures = 0;
+}
+
+void DSPTests::report(const char* component, const char* check, double value, double bound)
+{
+    const bool passed = value <= bound;
+    if (!passed)
+        ++failures;
+
+    std::printf("%-18s %-48s %10.3g (bound %8.3g)  %s\n", component, check, value, bound, passed ? "ok" : "FAILED");
+}
+
+void DSPTests::expect(const char* component, const char* check, bool passed)
+{
+    if (!passed)
+        ++failures;
+
+    std::printf("%-18s %-48s %29s  %s\n", component, check, "", passed ? "ok" : "FAILED");
+}
+
+double DSPTests::getInharmonicLevel(const std::vector<float>& signal, int numCycles)
+{
+    const int n = static_cast<int>(signal.size());
+
+    double mean = 0.0;
+    for (float x : signal)
+        mean += x;
+    mean /= n;
+
+    double total = 0.0;
+    for (float x : signal)
+        total += (x - mean) * (x - mean);
+
+    // DFT bins at each harmonic below Nyquist; with whole cycles each one lands on a bin
+    double harmonic = 0.0;
+    for (int bin = numCycles; 2 * bin < n; bin += numCycles)
+    {
+        std::complex<double> sum;
+        for (int i = 0; i < n; ++i)
+            sum += static_cast<double>(signal[static_cast<size_t>(i)])
+                 * std::polar(1.0, -2.0 * juce::MathConstants<double>::pi * bin * (static_cast<double>(i) / n));
+        harmonic += 2.0 * std::norm(sum) / n;
+    }
+
+    const double rest = std::max(total - harmonic, total * 1e-12);
+    return 10.0 * std::log10(rest / harmonic);
+}
+
+int main()
+{
+    // The processor's APVTS is a Timer, so JUCE's message manager has to exist
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    DSPTests::runOscillatorBankTests();
+    DSPTests::runStereoReverbTests();
+    DSPTests::runConvolutionReverbTests();
+    DSPTests::runQuadratureOscillatorTests();
+    DSPTests::runStereoPannerTests();
+    DSPTests::runHalfBandFilterTests();
+    DSPTests::runKarplusStrongTests();
+    DSPTests::runSequencerTests();
+    DSPTests::runProcessorTests();
+
+    if (failures > 0)
+    {
+        std::printf("\n%d check(s) FAILED\n", failures);
+        return 1;
+    }
+
+    std::printf("\nAll checks passed\n");
+    return 0;
+}
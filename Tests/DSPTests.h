@@ -0,0 +1,30 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+// Checks for the DSP components that need JUCE, one file per component, and for the
+// processor as a whole. main() in DSPTests.cpp runs them all and returns non-zero if any
+// check fails.
+namespace DSPTests
+{
+    // Print a measured value against its bound; a value above the bound is a failure
+    void report(const char* component, const char* check, double value, double bound);
+
+    // Print a check that either holds or doesn't
+    void expect(const char* component, const char* check, bool passed);
+
+    // For a signal holding a whole number of cycles: the power away from its harmonics
+    // (aliasing and noise; DC is left out) in dB relative to the power at them
+    double getInharmonicLevel(const std::vector<float>& signal, int numCycles);
+
+    void runOscillatorBankTests();
+    void runStereoReverbTests();
+    void runConvolutionReverbTests();
+    void runQuadratureOscillatorTests();
+    void runStereoPannerTests();
+    void runHalfBandFilterTests();
+    void runKarplusStrongTests();
+    void runSequencerTests();
+    void runProcessorTests();
+}
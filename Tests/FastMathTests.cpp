@@ -0,0 +1,353 @@
+// Accuracy and speed of FastMath, against double-precision libm, and RandomStream's block
+// fills.
+//
+// Each function is checked over the range its error bound in FastMath.h is documented for.
+// The block kernels run in every variant this CPU supports (see SimdDispatch), and each
+// variant must also give exactly the scalar results, since renders are meant to be the same
+// on every machine. Timings are printed in ns per sample and never fail the run.
+//
+// Returns non-zero if any check fails.
+
+#include "DSP/FastMath.h"
+#include "DSP/RandomStream.h"
+#include "DSP/SimdDispatch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using BlockFunction = void (*)(const float* input, float* output, int numSamples);
+
+    struct BlockVariant
+    {
+        SimdDispatch::Variant variant;
+        BlockFunction exp2;
+        BlockFunction sin2Pi;
+        BlockFunction tanh;
+    };
+
+    // Scalar first, then each wider set up to the one the CPU supports
+    std::vector<BlockVariant> getSupportedVariants()
+    {
+        using SimdDispatch::Variant;
+        const Variant widest = SimdDispatch::detectVariant();
+
+        std::vector<BlockVariant> variants;
+        variants.push_back({ Variant::Scalar, FastMath::exp2BlockScalar, FastMath::sin2PiBlockScalar, FastMath::tanhBlockScalar });
+       #if DFAM_FASTMATH_SSE2
+        variants.push_back({ Variant::Sse2, FastMath::exp2BlockSse2, FastMath::sin2PiBlockSse2, FastMath::tanhBlockSse2 });
+       #endif
+       #if DFAM_FASTMATH_AVX2
+        if (widest == Variant::Avx2 || widest == Variant::Avx512)
+            variants.push_back({ Variant::Avx2, FastMath::exp2BlockAvx2, FastMath::sin2PiBlockAvx2, FastMath::tanhBlockAvx2 });
+       #endif
+       #if DFAM_FASTMATH_AVX512
+        if (widest == Variant::Avx512)
+            variants.push_back({ Variant::Avx512, FastMath::exp2BlockAvx512, FastMath::sin2PiBlockAvx512, FastMath::tanhBlockAvx512 });
+       #endif
+        (void) widest;
+        return variants;
+    }
+
+    int failures = 0;
+
+    void report(const char* name, const char* variant, const char* errorType, double error, double bound, double nsPerSample)
+    {
+        const bool passed = error <= bound;
+        if (!passed)
+            ++failures;
+
+        std::printf("%-8s %-8s max %s error %9.3g (bound %7.1g) %7.2f ns/sample  %s\n",
+                    name, variant, errorType, error, bound, nsPerSample, passed ? "ok" : "FAILED");
+    }
+
+    // count values evenly spaced from start to end, both included
+    std::vector<float> makeInputs(double start, double end, int count)
+    {
+        std::vector<float> inputs(static_cast<size_t>(count));
+        for (int i = 0; i < count; ++i)
+            inputs[static_cast<size_t>(i)] = static_cast<float>(start + (end - start) * i / (count - 1));
+        return inputs;
+    }
+
+    // Average over enough repeats of a 1024-sample block to take a few milliseconds
+    template <typename Function>
+    double timePerSample(Function&& process)
+    {
+        constexpr int blockSize = 1024;
+        constexpr int repeats = 4096;
+
+        process(blockSize);  // warm up
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r)
+            process(blockSize);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        return std::chrono::duration<double, std::nano>(elapsed).count() / (static_cast<double>(blockSize) * repeats);
+    }
+
+    double timeBlock(BlockFunction function, const std::vector<float>& inputs)
+    {
+        std::vector<float> output(inputs.size());
+        return timePerSample([&](int n) { function(inputs.data(), output.data(), n); });
+    }
+
+    template <typename Function>
+    double timeScalar(Function function, const std::vector<float>& inputs)
+    {
+        std::vector<float> output(inputs.size());
+        return timePerSample([&](int n) {
+            for (int i = 0; i < n; ++i)
+                output[static_cast<size_t>(i)] = function(inputs[static_cast<size_t>(i)]);
+        });
+    }
+
+    double absoluteError(double value, double exact) { return std::abs(value - exact); }
+    double relativeError(double value, double exact) { return std::abs(value - exact) / std::abs(exact); }
+
+    // sin(2 pi x) with the whole cycles taken off exactly first
+    double exactSin2Pi(double phase)
+    {
+        return std::sin(2.0 * 3.14159265358979323846 * (phase - std::round(phase)));
+    }
+
+    //==========================================================================
+    // Block kernels, in each variant
+
+    struct BlockCase
+    {
+        const char* name;
+        BlockFunction BlockVariant::*function;
+        std::vector<float> inputs;
+        double (*exact)(double);
+        double (*error)(double, double);
+        const char* errorType;
+        double bound;
+    };
+
+    void testBlockKernels()
+    {
+        const std::vector<BlockCase> cases {
+            { "exp2", &BlockVariant::exp2, makeInputs(-126.0, 127.0, 1 << 20),
+              [](double x) { return std::exp2(x); }, relativeError, "relative", 2e-7 },
+            { "sin2Pi", &BlockVariant::sin2Pi, makeInputs(-64.0, 64.0, 1 << 20),
+              exactSin2Pi, absoluteError, "absolute", 2e-7 },
+            { "tanh", &BlockVariant::tanh, makeInputs(-20.0, 20.0, 1 << 20),
+              [](double x) { return std::tanh(x); }, absoluteError, "absolute", 1e-4 },
+        };
+
+        const auto variants = getSupportedVariants();
+        for (const auto& test : cases)
+        {
+            const int count = static_cast<int>(test.inputs.size());
+            std::vector<float> scalarOutput(test.inputs.size());
+            (variants.front().*test.function)(test.inputs.data(), scalarOutput.data(), count);
+
+            for (const auto& variant : variants)
+            {
+                const char* variantName = SimdDispatch::getVariantName(variant.variant);
+                std::vector<float> output(test.inputs.size());
+                (variant.*test.function)(test.inputs.data(), output.data(), count);
+
+                double maxError = 0.0;
+                for (size_t i = 0; i < output.size(); ++i)
+                    maxError = std::max(maxError, test.error(output[i], test.exact(test.inputs[i])));
+
+                report(test.name, variantName, test.errorType, maxError, test.bound, timeBlock(variant.*test.function, test.inputs));
+
+                bool matchesScalar = std::memcmp(output.data(), scalarOutput.data(), output.size() * sizeof(float)) == 0;
+
+                // Lengths that aren't a whole number of vectors go through each variant's tail
+                for (int length : { 1, 3, 7, 15, 17, 31 })
+                {
+                    std::vector<float> tailOutput(static_cast<size_t>(length));
+                    (variant.*test.function)(test.inputs.data(), tailOutput.data(), length);
+                    matchesScalar = matchesScalar && std::equal(tailOutput.begin(), tailOutput.end(), scalarOutput.begin());
+                }
+
+                if (!matchesScalar)
+                {
+                    std::printf("%-8s %-8s differs from the scalar results  FAILED\n", test.name, variantName);
+                    ++failures;
+                }
+            }
+        }
+    }
+
+    //==========================================================================
+    // Scalar-only functions
+
+    template <typename Function>
+    void testScalar(const char* name, Function function, const std::vector<float>& inputs, double (*exact)(double),
+                    double (*error)(double, double), const char* errorType, double bound)
+    {
+        double maxError = 0.0;
+        for (float x : inputs)
+            maxError = std::max(maxError, error(function(x), exact(x)));
+
+        report(name, "Scalar", errorType, maxError, bound, timeScalar(function, inputs));
+    }
+
+    void testScalarFunctions()
+    {
+        testScalar("exp", [](float x) { return FastMath::exp(x); }, makeInputs(-10.0, 10.0, 1 << 20),
+                   [](double x) { return std::exp(x); }, relativeError, "relative", 7e-7);
+        testScalar("log2", [](float x) { return FastMath::log2(x); }, makeInputs(1.0 / 256.0, 256.0, 1 << 20),
+                   [](double x) { return std::log2(x); }, absoluteError, "absolute", 4e-7);
+        testScalar("cos2Pi", [](float x) { return FastMath::cos2Pi(x); }, makeInputs(-1.0, 1.0, 1 << 20),
+                   [](double x) { return exactSin2Pi(x + 0.25); }, absoluteError, "absolute", 4e-7);
+        testScalar("tan", [](float x) { return FastMath::tan(x); }, makeInputs(-0.45 * 3.14159265358979323846, 0.45 * 3.14159265358979323846, 1 << 20),
+                   [](double x) { return std::tan(x); }, relativeError, "relative", 2e-6);
+
+        // pow's bound scales with the size of the result's exponent, so the error is taken
+        // relative to that bound and checked against 1
+        const auto bases = makeInputs(1.0 / 64.0, 64.0, 1024);
+        const auto exponents = makeInputs(-4.0, 4.0, 1024);
+        double maxScaledError = 0.0;
+        for (float base : bases)
+        {
+            for (float exponent : exponents)
+            {
+                const double exact = std::pow(static_cast<double>(base), static_cast<double>(exponent));
+                const double bound = 3e-7 * std::max(1.0, std::abs(std::log2(exact)));
+                maxScaledError = std::max(maxScaledError, relativeError(FastMath::pow(base, exponent), exact) / bound);
+            }
+        }
+
+        std::vector<float> output(bases.size());
+        const double nsPerSample = timePerSample([&](int n) {
+            for (int i = 0; i < n; ++i)
+                output[static_cast<size_t>(i)] = FastMath::pow(bases[static_cast<size_t>(i)], exponents[static_cast<size_t>(i)]);
+        });
+        report("pow", "Scalar", "scaled", maxScaledError, 1.0, nsPerSample);
+    }
+
+    //==========================================================================
+    // RandomStream
+
+    void expect(const char* name, const char* variant, const char* check, bool passed)
+    {
+        if (!passed)
+            ++failures;
+
+        std::printf("%-8s %-8s %-52s %s\n", name, variant, check, passed ? "ok" : "FAILED");
+    }
+
+    using FillFunction = void (*)(uint32_t key, uint32_t counter, float* output, int numSamples);
+
+    // Each wider fill against the scalar one, from a counter that isn't lane-aligned, over
+    // lengths that leave a tail of every size
+    void testRandomFillVariants()
+    {
+        using SimdDispatch::Variant;
+        const Variant widest = SimdDispatch::detectVariant();
+
+        std::vector<std::pair<Variant, FillFunction>> variants;
+       #if DFAM_FASTMATH_AVX2
+        if (widest == Variant::Avx2 || widest == Variant::Avx512)
+            variants.push_back({ Variant::Avx2, RandomStream::fillBipolarAvx2 });
+       #endif
+       #if DFAM_FASTMATH_AVX512
+        if (widest == Variant::Avx512)
+            variants.push_back({ Variant::Avx512, RandomStream::fillBipolarAvx512 });
+       #endif
+        (void) widest;
+
+        constexpr uint32_t key = 0x12345678u;
+        constexpr uint32_t counter = 0xfffffff5u;  // wraps part way through
+        std::vector<float> expected(1024);
+        RandomStream::fillBipolarScalar(key, counter, expected.data(), static_cast<int>(expected.size()));
+
+        for (const auto& [variant, fill] : variants)
+        {
+            bool matches = true;
+            for (int length = 1; length <= 1024; length += length < 40 ? 1 : 61)
+            {
+                std::vector<float> output(static_cast<size_t>(length));
+                fill(key, counter, output.data(), length);
+                matches = matches && std::equal(output.begin(), output.end(), expected.begin());
+            }
+            expect("random", SimdDispatch::getVariantName(variant), "fill matches the scalar values, every tail length", matches);
+        }
+    }
+
+    void testRandomStream()
+    {
+        testRandomFillVariants();
+
+        const char* const dispatched = SimdDispatch::getVariantName(SimdDispatch::getKernels().variant);
+
+        // The dispatched fill carries on the stream where the last call left it, in blocks
+        // that aren't whole vectors, and gives the values one at a time would
+        {
+            RandomStream filled, stepped;
+            filled.setSeed(1234u, 0u);
+            stepped.setSeed(1234u, 0u);
+
+            std::vector<float> output(4096);
+            for (int start = 0, length = 1; start < static_cast<int>(output.size()); start += length, length = length % 37 + 1)
+                filled.fillBipolar(output.data() + start, std::min(length, static_cast<int>(output.size()) - start));
+
+            bool matches = true;
+            bool inRange = true;
+            for (float value : output)
+            {
+                matches = matches && value == stepped.nextBipolar();
+                inRange = inRange && value >= -1.0f && value < 1.0f;
+            }
+            expect("random", dispatched, "fill in odd blocks matches nextBipolar()", matches);
+            expect("random", dispatched, "values in [-1, 1)", inRange);
+        }
+
+        // Streams of one seed, or one stream of different seeds, are unrelated
+        {
+            constexpr int length = 4096;
+            auto getValues = [](uint32_t seed, uint32_t streamId) {
+                RandomStream stream;
+                stream.setSeed(seed, streamId);
+                std::vector<float> values(static_cast<size_t>(length));
+                stream.fillBipolar(values.data(), length);
+                return values;
+            };
+
+            // The mean product of two independent uniform sequences has a standard
+            // deviation of 1 / (3 sqrt(length)), 0.005 here
+            auto unrelated = [](const std::vector<float>& a, const std::vector<float>& b) {
+                double sum = 0.0;
+                for (size_t i = 0; i < a.size(); ++i)
+                    sum += static_cast<double>(a[i]) * b[i];
+                return a != b && std::abs(sum / static_cast<double>(a.size())) < 0.03;
+            };
+
+            const auto reference = getValues(1234u, 0u);
+            expect("random", dispatched, "same seed and stream ID repeats", getValues(1234u, 0u) == reference);
+            expect("random", dispatched, "stream IDs 1 and 2 unrelated to 0",
+                   unrelated(getValues(1234u, 1u), reference) && unrelated(getValues(1234u, 2u), reference));
+            expect("random", dispatched, "seed 1235 unrelated to 1234", unrelated(getValues(1235u, 0u), reference));
+        }
+    }
+}
+
+int main()
+{
+    std::printf("FastMath, widest variant on this CPU: %s\n\n", SimdDispatch::getVariantName(SimdDispatch::detectVariant()));
+
+    testBlockKernels();
+    testScalarFunctions();
+    testRandomStream();
+
+    if (failures > 0)
+    {
+        std::printf("\n%d check(s) FAILED\n", failures);
+        return 1;
+    }
+
+    std::printf("\nAll checks passed\n");
+    return 0;
+}
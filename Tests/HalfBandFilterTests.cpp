@@ -0,0 +1,72 @@
+#include "DSPTests.h"
+#include "DSP/HalfBandFilter.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    // A sine at the given frequency (a fraction of the output rate) through numStages
+    // halvings; returns the output's amplitude and its delay in output samples, fitted over
+    // a whole number of cycles once the filters have settled
+    struct Fit
+    {
+        double amplitude;
+        double delay;
+    };
+
+    Fit decimateSine(double frequency, int numStages, int numCycles)
+    {
+        const int factor = 1 << numStages;
+        const int numOutput = static_cast<int>(std::lround(2.0 * numCycles / frequency));
+        const double w = juce::MathConstants<double>::twoPi * frequency;
+
+        std::vector<float> samples(static_cast<size_t>(numOutput * factor));
+        for (size_t n = 0; n < samples.size(); ++n)
+            samples[n] = static_cast<float>(std::sin(w * static_cast<double>(n) / factor));
+
+        std::vector<HalfBandFilter<1>> stages(static_cast<size_t>(numStages));
+        for (int stage = 0; stage < numStages; ++stage)
+        {
+            const float* input[] = { samples.data() };
+            float* output[] = { samples.data() };
+            stages[static_cast<size_t>(stage)].downsample(input, output, (numOutput * factor) >> (stage + 1));
+        }
+
+        double s = 0.0, c = 0.0;
+        for (int i = numOutput / 2; i < numOutput; ++i)
+        {
+            s += samples[static_cast<size_t>(i)] * std::sin(w * i);
+            c += samples[static_cast<size_t>(i)] * std::cos(w * i);
+        }
+        const double scale = 2.0 / (numOutput - numOutput / 2);
+        return { std::hypot(s, c) * scale, -std::atan2(c, s) / w };
+    }
+}
+
+void DSPTests::runHalfBandFilterTests()
+{
+    const char* const name = "HalfBandFilter";
+    char check[64];
+
+    // The delay the processor reports as latency: one halving's in full, each earlier one
+    // at half the weight of the next
+    for (int numStages = 1; numStages <= 3; ++numStages)
+    {
+        double expected = 0.0;
+        for (int stage = 0; stage < numStages; ++stage)
+            expected += HalfBandFilter<1>::getDownsampleDelay() / (1 << stage);
+
+        std::snprintf(check, sizeof(check), "%d halving(s), delay error in output samples", numStages);
+        report(name, check, std::abs(decimateSine(1.0 / 48.0, numStages, 100).delay - expected), 0.01);
+    }
+
+    // Flat through 0.2 of the input rate (0.4 of the output's), 70 dB down from 0.3 (0.6)
+    report(name, "passband edge, loss in dB", -20.0 * std::log10(decimateSine(0.4, 1, 2000).amplitude), 0.01);
+    for (const double frequency : { 0.6, 0.8, 0.95 })
+    {
+        // Above the output's Nyquist the sine folds back: measure it there
+        std::snprintf(check, sizeof(check), "%.2f of the output rate, level in dB", frequency);
+        report(name, check, 20.0 * std::log10(decimateSine(frequency, 1, 2000).amplitude), -69.0);
+    }
+}
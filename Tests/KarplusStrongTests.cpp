@@ -0,0 +1,85 @@
+#include "DSPTests.h"
+#include "DSP/KarplusStrong.h"
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    constexpr double SAMPLE_RATE = 48000.0;
+    constexpr double BASE_FREQUENCY = 65.41;  // C2, the resonator's step pitch 0
+
+    // Half a second of the string plucked by an impulse, once the pluck has left the loop
+    std::vector<float> pluck(float semitones, float lossCutoff)
+    {
+        std::vector<float> storage(static_cast<size_t>(KarplusStrong::getRequiredStorage(SAMPLE_RATE)));
+        KarplusStrong resonator;
+        resonator.prepare(SAMPLE_RATE, storage.data());
+
+        std::array<float, KarplusStrong::NUM_STEPS> pitches = {};
+        pitches.fill(semitones);
+        resonator.setStepPitches(pitches);
+        resonator.setDelayTime(0.0f);
+        resonator.setLossFilter(std::exp(-juce::MathConstants<float>::twoPi * lossCutoff / static_cast<float>(SAMPLE_RATE)));
+        resonator.setFeedback(0.99f);
+        resonator.setMix(1.0f);
+
+        std::vector<float> samples(static_cast<size_t>(SAMPLE_RATE * 0.6));
+        samples[0] = 1.0f;
+        resonator.process(samples.data(), static_cast<int>(samples.size()));
+        return std::vector<float>(samples.end() - static_cast<int>(SAMPLE_RATE * 0.5), samples.end());
+    }
+
+    // Frequency of the strongest partial within 50 cents of target, from the Hann-windowed
+    // spectrum scanned in tenths of a cent
+    double findPeak(const std::vector<float>& samples, double target)
+    {
+        const size_t n = samples.size();
+        std::vector<double> windowed(n);
+        for (size_t i = 0; i < n; ++i)
+            windowed[i] = samples[i] * (0.5 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * static_cast<double>(i) / static_cast<double>(n)));
+
+        double bestFrequency = target;
+        double bestPower = -1.0;
+        for (int tenths = -500; tenths <= 500; ++tenths)
+        {
+            const double frequency = target * std::exp2(tenths / 12000.0);
+            const auto rotation = std::polar(1.0, -juce::MathConstants<double>::twoPi * frequency / SAMPLE_RATE);
+            std::complex<double> phasor(1.0), sum;
+            for (const double x : windowed)
+            {
+                sum += x * phasor;
+                phasor *= rotation;
+            }
+
+            if (std::norm(sum) > bestPower)
+            {
+                bestPower = std::norm(sum);
+                bestFrequency = frequency;
+            }
+        }
+        return bestFrequency;
+    }
+}
+
+void DSPTests::runKarplusStrongTests()
+{
+    const char* const name = "KarplusStrong";
+    char check[64];
+
+    // The loop length is corrected for the loss filter's phase delay and read through the
+    // allpass, so the string sounds the step pitch across the range, up to short loops
+    // where a whole-sample length would be tens of cents out
+    for (const float semitones : { 0.0f, 19.0f, 36.0f, 48.0f })
+    {
+        const double target = BASE_FREQUENCY * std::exp2(semitones / 12.0);
+        for (const float lossCutoff : { 12000.0f, 3000.0f })
+        {
+            const double cents = 1200.0 * std::log2(findPeak(pluck(semitones, lossCutoff), target) / target);
+            std::snprintf(check, sizeof(check), "%.0f Hz, loss filter at %.0f Hz, error in cents", target, lossCutoff);
+            report(name, check, std::abs(cents), 2.0);
+        }
+    }
+}
@@ -0,0 +1,140 @@
+#include "DSPTests.h"
+#include "DSP/Oscillator.h"
+#include "DSP/OscillatorBank.h"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    constexpr double SAMPLE_RATE = 48000.0;
+    constexpr int NUM_SAMPLES = 4800;  // a tenth of a second, so whole-Hz tones hold whole cycles
+
+    struct Patch
+    {
+        float vco1Hz = 1000.0f;
+        float vco2Hz = 1000.0f;
+        float wave = 0.0f;
+        float vco1Level = 1.0f;
+        float vco2Level = 0.0f;
+        float subLevel = 0.0f;
+        bool hardSync = false;
+        bool bandLimited = false;
+        bool wavetable = false;
+    };
+
+    // The second NUM_SAMPLES of output, so the start from phase 0 isn't measured
+    std::vector<float> render(const Patch& patch)
+    {
+        OscillatorBank bank;
+        bank.prepare(SAMPLE_RATE);
+        bank.setFrequencies(patch.vco1Hz, patch.vco2Hz);
+        bank.setBandLimited(patch.bandLimited);
+        bank.setWavetableEnabled(patch.wavetable);
+
+        const std::vector<float> ones(2 * NUM_SAMPLES, 1.0f);
+        const std::vector<float> zeros(2 * NUM_SAMPLES, 0.0f);
+        const std::vector<float> wave(2 * NUM_SAMPLES, patch.wave);
+        const std::vector<float> vco1Level(2 * NUM_SAMPLES, patch.vco1Level);
+        const std::vector<float> vco2Level(2 * NUM_SAMPLES, patch.vco2Level);
+
+        OscillatorBank::Controls controls;
+        controls.vco1PitchMult = ones.data();
+        controls.vco2PitchMult = ones.data();
+        controls.vco1Wave = wave.data();
+        controls.vco2Wave = wave.data();
+        controls.fmAmount = zeros.data();
+        controls.vco1Level = vco1Level.data();
+        controls.vco2Level = vco2Level.data();
+        controls.noise = zeros.data();
+        controls.subLevel = patch.subLevel;
+        controls.hardSync = patch.hardSync;
+
+        std::vector<float> output(2 * NUM_SAMPLES);
+        bank.process(controls, 2 * NUM_SAMPLES, 1, output.data());
+        return { output.begin() + NUM_SAMPLES, output.end() };
+    }
+
+    // VCO1's phase at each sample render() returns, from the same 32-bit accumulator the
+    // bank uses
+    std::vector<double> getPhases(float frequency)
+    {
+        const auto step = static_cast<uint32_t>(frequency / SAMPLE_RATE * 4294967296.0 + 0.5);
+        std::vector<double> phases(NUM_SAMPLES);
+        auto phase = static_cast<uint32_t>(step * static_cast<uint32_t>(NUM_SAMPLES));
+        for (auto& p : phases)
+        {
+            p = phase / 4294967296.0;
+            phase += step;
+        }
+        return phases;
+    }
+
+    double getMaxError(const std::vector<float>& output, const std::vector<double>& phases, float (*generator)(double))
+    {
+        double maxError = 0.0;
+        for (size_t i = 0; i < output.size(); ++i)
+            maxError = std::max(maxError, std::abs(static_cast<double>(output[i]) - generator(phases[i])));
+        return maxError;
+    }
+}
+
+void DSPTests::runOscillatorBankTests()
+{
+    const char* const name = "OscillatorBank";
+
+    // The naive waveforms are the generators, sampled at the accumulator's phase
+    {
+        Patch patch;
+        const auto phases = getPhases(patch.vco1Hz);
+        report(name, "sine against Oscillator::generateSine", getMaxError(render(patch), phases, Oscillator::generateSine), 1e-6);
+
+        patch.wave = 1.0f;
+        report(name, "chaos against Oscillator::generateChaos", getMaxError(render(patch), phases, Oscillator::generateChaos), 1e-4);
+    }
+
+    // A 3010 Hz square: 301 cycles, with its upper harmonics folding back between the bins
+    // of the real ones
+    {
+        Patch patch;
+        patch.vco1Hz = 3010.0f;
+        patch.wave = 0.66f;
+        const double naive = getInharmonicLevel(render(patch), 301);
+
+        patch.bandLimited = true;
+        const double polyBlep = getInharmonicLevel(render(patch), 301);
+
+        patch.bandLimited = false;
+        patch.wavetable = true;
+        const double wavetable = getInharmonicLevel(render(patch), 301);
+
+        report(name, "PolyBLEP square, aliasing re naive (dB)", polyBlep - naive, -10.0);
+        report(name, "wavetable square, aliasing re naive (dB)", wavetable - naive, -40.0);
+    }
+
+    // The sub is a square an octave below VCO1: 51 cycles of 510 Hz
+    {
+        Patch patch;
+        patch.vco1Hz = 1020.0f;
+        patch.vco1Level = 0.0f;
+        patch.subLevel = 1.0f;
+        patch.bandLimited = true;
+        report(name, "sub an octave down, aliasing (dB)", getInharmonicLevel(render(patch), 51), -30.0);
+    }
+
+    // VCO1 reset by a 1010 Hz VCO2 repeats at 1010 Hz. Resetting at the sub-sample position
+    // of VCO2's wrap, with corrections, keeps that cleaner than resetting on the sample.
+    {
+        Patch patch;
+        patch.vco1Hz = 1370.0f;
+        patch.vco2Hz = 1010.0f;
+        patch.wave = 0.33f;
+        patch.hardSync = true;
+        const double naive = getInharmonicLevel(render(patch), 101);
+
+        patch.bandLimited = true;
+        const double polyBlep = getInharmonicLevel(render(patch), 101);
+
+        report(name, "band-limited hard sync, aliasing re naive (dB)", polyBlep - naive, -6.0);
+    }
+}
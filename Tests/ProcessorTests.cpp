@@ -0,0 +1,166 @@
+#include "DSPTests.h"
+#include "PluginProcessor.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    constexpr double SAMPLE_RATE = 48000.0;
+    constexpr int MAX_BLOCK_SIZE = 512;
+
+    void setParameter(DFAMSynthAudioProcessor& processor, const juce::String& id, float value)
+    {
+        auto* parameter = processor.getAPVTS().getParameter(id);
+        jassert(parameter != nullptr);
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    // A running sequence whose step lengths aren't whole samples: swung, ping-ponging
+    // through pitched and panned steps into the resonator and reverb. The ring mod is left
+    // out: its stage idles a sub-block at a time, and its carrier stands still meanwhile,
+    // so where the carrier picks up again depends on how the blocks fell.
+    void setUpSequence(DFAMSynthAudioProcessor& processor)
+    {
+        setParameter(processor, "seqRun", 1.0f);
+        setParameter(processor, "tempo", 187.0f);
+        setParameter(processor, "swing", 0.7f);
+        setParameter(processor, "seqDirection", 2.0f);
+        setParameter(processor, "delayMix", 0.3f);
+        setParameter(processor, "reverbMix", 0.3f);
+
+        for (int step = 0; step < Sequencer::NUM_STEPS; ++step)
+        {
+            const juce::String number(step + 1);
+            setParameter(processor, "seqPitch" + number, static_cast<float>((step * 5) % 13 - 6));
+            setParameter(processor, "seqPan" + number, static_cast<float>(step % 3 - 1) * 0.7f);
+        }
+    }
+
+    struct Output
+    {
+        std::vector<float> left;
+        std::vector<float> right;
+    };
+
+    // numSamples of the processor's output from prepareToPlay, in host blocks of blockSize,
+    // with midi's events (timed from the start of the render) passed in the blocks they fall in
+    Output render(DFAMSynthAudioProcessor& processor, int numSamples, int blockSize, const juce::MidiBuffer& midi = {})
+    {
+        processor.setRateAndBufferSizeDetails(SAMPLE_RATE, MAX_BLOCK_SIZE);
+        processor.prepareToPlay(SAMPLE_RATE, MAX_BLOCK_SIZE);
+
+        Output output { std::vector<float>(static_cast<size_t>(numSamples)), std::vector<float>(static_cast<size_t>(numSamples)) };
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer blockMidi;
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            const int n = std::min(blockSize, numSamples - start);
+            buffer.setSize(2, n, false, false, true);
+            buffer.clear();
+
+            blockMidi.clear();
+            blockMidi.addEvents(midi, start, n, -start);
+            processor.processBlock(buffer, blockMidi);
+
+            std::copy(buffer.getReadPointer(0), buffer.getReadPointer(0) + n, output.left.begin() + start);
+            std::copy(buffer.getReadPointer(1), buffer.getReadPointer(1) + n, output.right.begin() + start);
+        }
+        return output;
+    }
+
+    Output renderSequence(int numSamples, int blockSize, const juce::MidiBuffer& midi = {})
+    {
+        DFAMSynthAudioProcessor processor;
+        setUpSequence(processor);
+        return render(processor, numSamples, blockSize, midi);
+    }
+
+    // The sequence with every random source in use (the noise, an S&H LFO and the random
+    // mod source), from the given seed
+    Output renderRandomSequence(int numSamples, uint32_t seed)
+    {
+        DFAMSynthAudioProcessor processor;
+        setUpSequence(processor);
+        setParameter(processor, "noiseLevel", 0.5f);
+        setParameter(processor, "lfoWave", 5.0f);
+        setParameter(processor, "lfoRate", 7.0f);
+        setParameter(processor, "modSrc1", 1.0f);
+        setParameter(processor, "modDst1", 1.0f);
+        setParameter(processor, "modAmt1", 0.5f);
+        setParameter(processor, "modSrc2", 6.0f);
+        setParameter(processor, "modDst2", 6.0f);
+        setParameter(processor, "modAmt2", 0.8f);
+        processor.setRandomSeed(seed);
+        return render(processor, numSamples, MAX_BLOCK_SIZE);
+    }
+
+    // The first sample at which either channel differs, or -1
+    int getFirstDifference(const Output& a, const Output& b)
+    {
+        for (size_t i = 0; i < a.left.size(); ++i)
+            if (a.left[i] != b.left[i] || a.right[i] != b.right[i])
+                return static_cast<int>(i);
+        return -1;
+    }
+
+    bool operator==(const Output& a, const Output& b)
+    {
+        return getFirstDifference(a, b) < 0;
+    }
+
+    double getMaxDifference(const Output& a, const Output& b)
+    {
+        double maxDifference = 0.0;
+        for (size_t i = 0; i < a.left.size(); ++i)
+            maxDifference = std::max({ maxDifference, std::abs(static_cast<double>(a.left[i]) - b.left[i]),
+                                       std::abs(static_cast<double>(a.right[i]) - b.right[i]) });
+        return maxDifference;
+    }
+}
+
+void DSPTests::runProcessorTests()
+{
+    const char* const name = "Processor";
+    char check[64];
+
+    // The steps trigger on the same samples wherever the host's blocks split the render
+    // (see the sequencer's checks), so the output only differs by the rounding in loops
+    // that run a sub-block at a time. A step one sample out would differ by far more.
+    {
+        const int numSamples = static_cast<int>(SAMPLE_RATE * 3.0);
+        const auto reference = renderSequence(numSamples, MAX_BLOCK_SIZE);
+        for (const int blockSize : { 1, 37, 64 })
+        {
+            std::snprintf(check, sizeof(check), "sequence, %d- vs 512-sample blocks, max difference", blockSize);
+            report(name, check, getMaxDifference(renderSequence(numSamples, blockSize), reference), 1e-6);
+        }
+    }
+
+    // A note-on (which retunes the oscillators; the steps trigger the envelopes) takes effect
+    // on the sample it's timed at, part way through a host block and a step. That sample
+    // still holds the phase reached at the old pitch, so the output moves off from the next.
+    {
+        const int numSamples = static_cast<int>(SAMPLE_RATE * 1.0);
+        const int noteSample = 31300;
+        juce::MidiBuffer midi;
+        midi.addEvent(juce::MidiMessage::noteOn(1, 48, static_cast<juce::uint8>(100)), noteSample);
+
+        for (const int blockSize : { 512, 37, 1 })
+        {
+            const int firstDifference = getFirstDifference(renderSequence(numSamples, blockSize, midi),
+                                                           renderSequence(numSamples, blockSize));
+            std::snprintf(check, sizeof(check), "note-on in %d-sample blocks, onset error", blockSize);
+            report(name, check, std::abs(firstDifference - (noteSample + 1)), 0.0);
+        }
+    }
+
+    // Two instances with one seed render the same; another seed gives other noise
+    {
+        const int numSamples = static_cast<int>(SAMPLE_RATE * 2.0);
+        const auto reference = renderRandomSequence(numSamples, 1234u);
+        expect(name, "same seed, second instance renders bit-identical", renderRandomSequence(numSamples, 1234u) == reference);
+        expect(name, "another seed renders differently", getFirstDifference(renderRandomSequence(numSamples, 1235u), reference) >= 0);
+    }
+}
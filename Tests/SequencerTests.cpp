@@ -0,0 +1,100 @@
+#include "DSPTests.h"
+#include "Sequencer/Sequencer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    constexpr double SAMPLE_RATE = 48000.0;
+    constexpr int NUM_SAMPLES = 48000 * 10;
+    constexpr int SUB_BLOCK_SIZE = 64;  // as the processor's
+
+    struct Trigger
+    {
+        int sample;
+        int step;
+
+        bool operator==(const Trigger& other) const { return sample == other.sample && step == other.step; }
+    };
+
+    // Swung, ping-ponging steps whose lengths aren't whole samples
+    void setUp(Sequencer& sequencer)
+    {
+        sequencer.prepare(SAMPLE_RATE);
+        sequencer.setTempo(187.0f);
+        sequencer.setSwing(0.7f);
+        sequencer.setDirection(2);
+        sequencer.setRunning(true);
+    }
+
+    // The triggers with process() called on every sample
+    std::vector<Trigger> tickEverySample()
+    {
+        Sequencer sequencer;
+        setUp(sequencer);
+
+        std::vector<Trigger> triggers;
+        for (int i = 0; i < NUM_SAMPLES; ++i)
+            if (sequencer.process())
+                triggers.push_back({ i, sequencer.getCurrentStep() });
+        return triggers;
+    }
+
+    // The triggers as processBlock schedules them: host blocks of blockSize, split into
+    // sub-blocks that end before the next step, with process() on each one's first sample
+    std::vector<Trigger> schedule(int blockSize)
+    {
+        Sequencer sequencer;
+        setUp(sequencer);
+
+        std::vector<Trigger> triggers;
+        for (int hostStart = 0; hostStart < NUM_SAMPLES; hostStart += blockSize)
+        {
+            const int numSamples = std::min(blockSize, NUM_SAMPLES - hostStart);
+            int subBlockSize = 0;
+            for (int start = 0; start < numSamples; start += subBlockSize)
+            {
+                if (sequencer.process())
+                    triggers.push_back({ hostStart + start, sequencer.getCurrentStep() });
+
+                subBlockSize = std::min(SUB_BLOCK_SIZE, numSamples - start);
+                subBlockSize = std::min(subBlockSize - 1, sequencer.samplesUntilNextStep()) + 1;
+                sequencer.advance(subBlockSize - 1);
+            }
+        }
+        return triggers;
+    }
+}
+
+void DSPTests::runSequencerTests()
+{
+    const char* const name = "Sequencer";
+    char check[64];
+
+    const auto reference = tickEverySample();
+
+    // Each step triggers on the sample its swung length runs out on, counted from the
+    // fractional boundary before it, so the steps don't drift
+    {
+        const double samplesPerStep = SAMPLE_RATE * 60.0 / (187.0 * 2.0);
+        double boundary = 0.0;
+        double maxError = 0.0;
+        for (size_t k = 0; k < reference.size(); ++k)
+        {
+            // Step k + 1 starts when step k, on- or off-beat, has run out
+            const int fromStep = k == 0 ? 0 : reference[k - 1].step;
+            boundary += samplesPerStep * (fromStep % 2 == 1 ? 1.2 : 0.8);
+            maxError = std::max(maxError, std::abs(reference[k].sample + 1 - std::ceil(boundary - 1e-9)));
+        }
+        report(name, "trigger against the swung boundary, samples", maxError, 0.0);
+        expect(name, "ping-pong visits 7 then turns back", reference.size() > 8 && reference[6].step == 7 && reference[7].step == 6);
+    }
+
+    for (const int blockSize : { 1, 37, 64, 512 })
+    {
+        std::snprintf(check, sizeof(check), "%d-sample blocks, triggers as ticked per sample", blockSize);
+        expect(name, check, schedule(blockSize) == reference);
+    }
+}
@@ -0,0 +1,90 @@
+#include "DSPTests.h"
+#include "DSP/StereoPanner.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    constexpr double SAMPLE_RATE = 48000.0;
+
+    struct Output
+    {
+        std::vector<float> left;
+        std::vector<float> right;
+    };
+
+    // A constant input of one through the panner, in blocks of blockSize, so the output is
+    // the gains
+    Output render(const std::vector<float>& pan, int blockSize, bool stereo = true)
+    {
+        StereoPanner panner;
+        panner.prepare(SAMPLE_RATE);
+
+        const std::vector<float> input(pan.size(), 1.0f);
+        Output output { std::vector<float>(pan.size()), std::vector<float>(stereo ? pan.size() : 0) };
+        const int numSamples = static_cast<int>(pan.size());
+        for (int start = 0; start < numSamples; start += blockSize)
+            panner.process(input.data() + start, pan.data() + start, output.left.data() + start,
+                           stereo ? output.right.data() + start : nullptr, std::min(blockSize, numSamples - start));
+        return output;
+    }
+
+    double getMaxDifference(const std::vector<float>& a, const std::vector<float>& b)
+    {
+        double maxDifference = 0.0;
+        for (size_t i = 0; i < a.size(); ++i)
+            maxDifference = std::max(maxDifference, std::abs(static_cast<double>(a[i]) - b[i]));
+        return maxDifference;
+    }
+}
+
+void DSPTests::runStereoPannerTests()
+{
+    const char* const name = "StereoPanner";
+    const int rampLength = static_cast<int>(SAMPLE_RATE * StereoPanner::RAMP_SECONDS);
+
+    // A held pan gives the equal-power gains from the first sample
+    {
+        double maxError = 0.0;
+        for (int step = 0; step <= 1000; ++step)
+        {
+            const float pan = -1.0f + 2.0f * static_cast<float>(step) / 1000.0f;
+            const auto output = render(std::vector<float>(64, pan), 64);
+            const double angle = (pan + 1.0) * juce::MathConstants<double>::pi / 4.0;
+            maxError = std::max({ maxError, std::abs(output.left[63] - std::cos(angle)), std::abs(output.right[63] - std::sin(angle)) });
+        }
+        report(name, "held pan against the equal-power law, max error", maxError, 5e-6);
+    }
+
+    // A jump from hard left to hard right ramps over the ramp length, on the update grid
+    std::vector<float> pan(4800, -1.0f);
+    std::fill(pan.begin() + 1000, pan.end(), 1.0f);
+    {
+        const auto output = render(pan, 512);
+        double maxStep = 0.0;
+        for (size_t i = 1; i < output.left.size(); ++i)
+            maxStep = std::max({ maxStep, std::abs(static_cast<double>(output.left[i]) - output.left[i - 1]),
+                                 std::abs(static_cast<double>(output.right[i]) - output.right[i - 1]) });
+        report(name, "pan jump, largest gain change per sample x ramp", maxStep * rampLength, 1.0001);
+
+        const auto settled = static_cast<size_t>(1000 + 2 * rampLength);
+        report(name, "pan jump, gain error two ramps later",
+               std::max(std::abs(output.left[settled]), std::abs(output.right[settled] - 1.0f)), 1e-6);
+    }
+
+    // The ramps run on their own grid, so the block size doesn't change the output (beyond
+    // rounding in the vector and scalar loops)
+    for (size_t i = 0; i < pan.size(); ++i)
+        pan[i] = static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * 3.0 * static_cast<double>(i) / SAMPLE_RATE))
+               + (i % 1200 < 600 ? -0.5f : 0.5f);
+    {
+        const auto whole = render(pan, 512);
+        const auto split = render(pan, 37);
+        report(name, "37- against 512-sample blocks, max difference",
+               std::max(getMaxDifference(whole.left, split.left), getMaxDifference(whole.right, split.right)), 1e-6);
+
+        const auto mono = render(pan, 512, false);
+        report(name, "mono against the stereo left channel", getMaxDifference(mono.left, whole.left), 0.0);
+    }
+}
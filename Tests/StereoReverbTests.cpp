@@ -0,0 +1,153 @@
+#include "DSPTests.h"
+#include "DSP/StereoReverb.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    constexpr double SAMPLE_RATE = 48000.0;
+    constexpr int BLOCK_SIZE = 512;
+
+    struct ImpulseResponse
+    {
+        std::vector<float> left;
+        std::vector<float> right;
+    };
+
+    // The wet signal after a unit impulse, in host-sized blocks, at the decimation the
+    // cutoff allows
+    ImpulseResponse renderImpulse(StereoReverb::Quality quality, float decay, float cutoff, double seconds, bool stereo = true)
+    {
+        std::vector<float> storage(static_cast<size_t>(StereoReverb::getRequiredStorage(SAMPLE_RATE)));
+        StereoReverb reverb;
+        reverb.prepare(SAMPLE_RATE, storage.data());
+        reverb.setQuality(quality);
+        reverb.setDecay(decay);
+        reverb.setFilterCutoff(cutoff);
+        reverb.setDecimation(reverb.chooseDecimation(cutoff));
+        reverb.setMix(1.0f);
+
+        const int numSamples = static_cast<int>(seconds * SAMPLE_RATE);
+        ImpulseResponse response { std::vector<float>(static_cast<size_t>(numSamples)),
+                                   std::vector<float>(static_cast<size_t>(numSamples)) };
+        response.left[0] = 1.0f;
+        response.right[0] = 1.0f;
+
+        for (int start = 0; start < numSamples; start += BLOCK_SIZE)
+            reverb.process(response.left.data() + start, stereo ? response.right.data() + start : nullptr,
+                           std::min(BLOCK_SIZE, numSamples - start));
+
+        if (!stereo)
+            response.right.clear();
+        return response;
+    }
+
+    // Time for the lows (below about 300 Hz) to fall 60 dB, from the slope of the
+    // backward-integrated energy between -5 and -35 dB (T30)
+    double measureT60(const std::vector<float>& response)
+    {
+        const double coeff = std::exp(-2.0 * juce::MathConstants<double>::pi * 300.0 / SAMPLE_RATE);
+        std::vector<double> lows(response.size());
+        double state = 0.0;
+        for (size_t i = 0; i < response.size(); ++i)
+            lows[i] = state = response[i] + (state - response[i]) * coeff;
+
+        std::vector<double> energy(response.size() + 1, 0.0);
+        for (size_t i = response.size(); i-- > 0;)
+            energy[i] = energy[i + 1] + lows[i] * lows[i];
+
+        const auto timeAtLevel = [&energy](double dB)
+        {
+            const double threshold = energy[0] * std::pow(10.0, dB / 10.0);
+            size_t i = 0;
+            while (i < energy.size() && energy[i] > threshold)
+                ++i;
+            return static_cast<double>(i) / SAMPLE_RATE;
+        };
+
+        return 2.0 * (timeAtLevel(-35.0) - timeAtLevel(-5.0));
+    }
+
+    double measureCorrelation(const std::vector<float>& left, const std::vector<float>& right)
+    {
+        double lr = 0.0, ll = 0.0, rr = 0.0;
+        for (size_t i = 0; i < left.size(); ++i)
+        {
+            lr += static_cast<double>(left[i]) * right[i];
+            ll += static_cast<double>(left[i]) * left[i];
+            rr += static_cast<double>(right[i]) * right[i];
+        }
+        return lr / std::sqrt(ll * rr);
+    }
+}
+
+void DSPTests::runStereoReverbTests()
+{
+    const char* const name = "StereoReverb";
+    const char* const tierNames[] = { "Eco", "Standard", "High" };
+
+    char check[64];
+
+    for (int tier = 0; tier < 3; ++tier)
+    {
+        const auto quality = static_cast<StereoReverb::Quality>(tier);
+
+        // Decay 0 to 1 sets 0.8 to 2.4 s at low frequencies (the damping shortens the highs),
+        // and widens the image from 0.6 to 0.9
+        for (float decay : { 0.0f, 1.0f })
+        {
+            const double expected = 0.8 + 1.6 * decay;
+            const auto response = renderImpulse(quality, decay, 20000.0f, 2.0 * expected);
+
+            std::snprintf(check, sizeof(check), "%s decay %.0f, T60 error re %.1f s", tierNames[tier], decay, expected);
+            report(name, check, std::abs(measureT60(response.left) / expected - 1.0), 0.05);
+
+            std::snprintf(check, sizeof(check), "%s decay %.0f, left/right correlation", tierNames[tier], decay);
+            report(name, check, measureCorrelation(response.left, response.right), decay > 0.5f ? 0.25 : 0.6);
+        }
+    }
+
+    // Mono output is the stereo output's left channel
+    {
+        const auto stereo = renderImpulse(StereoReverb::Quality::High, 0.5f, 20000.0f, 0.5);
+        const auto mono = renderImpulse(StereoReverb::Quality::High, 0.5f, 20000.0f, 0.5, false);
+        double maxError = 0.0;
+        for (size_t i = 0; i < mono.left.size(); ++i)
+            maxError = std::max(maxError, std::abs(static_cast<double>(mono.left[i]) - stereo.left[i]));
+        report(name, "mono against the stereo left channel", maxError, 0.0);
+    }
+
+    // At a half and a quarter of the rate the network keeps its decay time
+    for (const float cutoff : { 5000.0f, 2000.0f })
+    {
+        const auto response = renderImpulse(StereoReverb::Quality::Standard, 1.0f, cutoff, 4.8);
+        std::snprintf(check, sizeof(check), "Standard decay 1, %.0f Hz cutoff, T60 error", cutoff);
+        report(name, check, std::abs(measureT60(response.left) / 2.4 - 1.0), 0.05);
+    }
+
+    // The factor follows the cutoff, but a cutoff wandering around a threshold (6 kHz for a
+    // half at 48 kHz) changes it once, not on every crossing
+    {
+        std::vector<float> storage(static_cast<size_t>(StereoReverb::getRequiredStorage(SAMPLE_RATE)));
+        StereoReverb reverb;
+        reverb.prepare(SAMPLE_RATE, storage.data());
+
+        reverb.setDecimation(reverb.chooseDecimation(2000.0f));
+        expect(name, "2 kHz cutoff runs at a quarter of the rate", reverb.getDecimation() == 4);
+        reverb.setDecimation(reverb.chooseDecimation(12000.0f));
+        expect(name, "12 kHz cutoff runs at the full rate", reverb.getDecimation() == 1);
+        reverb.setDecimation(reverb.chooseDecimation(4000.0f));
+        expect(name, "4 kHz cutoff runs at half the rate", reverb.getDecimation() == 2);
+
+        int changes = 0;
+        for (int i = 0; i < 100; ++i)
+        {
+            const int previous = reverb.getDecimation();
+            reverb.setDecimation(reverb.chooseDecimation(i % 2 == 0 ? 6300.0f : 5700.0f));
+            changes += reverb.getDecimation() != previous ? 1 : 0;
+        }
+        report(name, "factor changes, cutoff alternating 5.7/6.3 kHz", changes, 1.0);
+    }
+}